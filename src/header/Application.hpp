@@ -5,17 +5,35 @@
 #include "Exception.hpp"
 #include "Graphics.hpp"
 #include "Transformations.hpp"
+#include "ImageTracer.hpp"
+#include "CoefficientFile.hpp"
+#include "Scene.hpp"
+#include "Snapshot.hpp"
+#include "StartupTimer.hpp"
+#include "JobSystem.hpp"
 #include <string>
 #include <memory>
 #include <iostream>
+#include <future>
+#include <functional>
 
 namespace Fourier {
 
+//
+// KiWi Resources decoded by the loading Thread (GUI creation itself happens on the Main Thread)
+//
+struct GuiResources {
+	KW_Surface* Tileset;
+	KW_Font* Font;
+	double LoadTime;
+};
+
 //
 // Application
 //
 // Managing all SDL2 and KiwiGUI Ressources
 // Creates a Window and runs the main Event loop
+// Owns the JobSystem, shared by all parallel work (Transformations, Image-Tracing, Rasterization)
 //
 class Application {
 private:
@@ -23,14 +41,35 @@ private:
 	const std::string _resourcePath;
 	const uint _windowWidth, _windowHeight;
 	int _actualWidth, _actualHeight;
-	std::vector<byte> _backgroundPixels;
+	// Window size after creation, used to fit loaded Scenes (constant, so loading Threads can read it)
+	int _startWidth, _startHeight;
+	StartupTimer _startup;
+	bool _firstFrameShown, _startupReported;
+	double _sceneLoadTime;
+	JobSystem _jobs;
+	Canvas _canvas;
+	Snapshot<Scene> _scene;
+	// Working copy of the current Scene, animated and edited by the Main Thread only
+	std::vector<Circle> _circles;
+	Trajectory _trajectory;
+	float _angle;
+	int _dragCircle;
+	// A Drag ended: The edited Circles are written back into the Scene with the next Frame
+	bool _editFinished;
 	std::shared_ptr<SDL_Window> _window;
 	std::shared_ptr<SDL_Renderer> _renderer;
 	std::shared_ptr<SDL_Texture> _background;
+	std::shared_ptr<SDL_Texture> _guiLayer;
 	std::shared_ptr<KW_RenderDriver> _driver;
 	std::shared_ptr<KW_GUI> _gui;
 	KW_Surface* _surface;
 	KW_Font* _font;
+	bool _guiDirty;
+	// Running in the background while the first Frames are already shown
+	std::future<GuiResources> _resources;
+	std::future<void> _loading;
+	// Writes finished edits back into the Scene
+	std::future<void> _editing;
 
 public:
 	Application(std::string&& appName, uint&& windowWidth, uint&& windowHeight, std::string&& resourcePath);
@@ -39,15 +78,35 @@ public:
 	Application& operator=(const Application&) = delete;
 
 	bool InitApplication();
+	bool LoadImage(const std::string& file);
+	bool LoadScene(const std::string& file);
+	bool SaveScene(const std::string& file, bool half);
+	void LoadAsync(std::function<void()> task);
+	void EditCircle(size_t index, float radius, float angleOffset);
+	void PublishEdits(uint64_t epoch);
 	int Run();
 
+	// Mark the cached GUI Layer as outdated (call after any Widget change)
+	inline void InvalidateGUI() { _guiDirty = true; }
+
 	~Application();
 
 private:
 	void SetupWindow();
 	void SetupSDL();
+	GuiResources LoadGuiResources();
 	void SetupKiwiGUI();
+	void UpdateStartup();
 	void OnWindowResize(Graphics& graphics);
+	void OnRenderReset(Graphics& graphics);
+	void CreateTextures(Graphics& graphics);
+	template <class F>
+	bool MainLoop(Graphics& graphics, const F& frame);
+	void SetScene(std::unique_ptr<Scene> scene);
+	Vec2 SumDot(const Scene& scene, float angle);
+	void OnGuiEvent(const SDL_Event& event);
+	void OnEditEvent(const SDL_Event& event);
+	void PaintGUI();
 };
 
 // Custom Deleters called on shared_ptr destruction to cleanup SDL resources
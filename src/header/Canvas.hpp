@@ -0,0 +1,113 @@
+
+#ifndef FOURIER_CANVAS_H
+#define FOURIER_CANVAS_H
+
+#include "Color.hpp"
+#include "PixelKernels.hpp"
+#include "JobSystem.hpp"
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace Fourier {
+
+// Tiles are TILE_SIZE x TILE_SIZE Pixels (power of two, so Tile and Pixel index are shifts and masks)
+static const int TILE_SHIFT = 6;
+static const int TILE_SIZE = 1 << TILE_SHIFT;
+static const size_t TILE_PIXELS = (size_t)TILE_SIZE * TILE_SIZE;
+// Tiles allocated at once by the TilePool (64 Tiles = 1 MiB)
+static const size_t TILE_POOL_BLOCK = 64;
+
+//
+// TilePool
+//
+// Fixed-size allocator for Tile Pixel memory
+// Tiles are carved out of big Blocks and recycled over a free-list, so allocating a Tile
+// while drawing is just a pop (Blocks are only freed with the Pool)
+//
+class TilePool {
+private:
+	std::vector<std::unique_ptr<ARGB[]>> _blocks;
+	std::vector<ARGB*> _free;
+
+public:
+	TilePool() = default;
+	TilePool(const TilePool&) = delete;
+	TilePool& operator=(const TilePool&) = delete;
+
+	ARGB* Acquire();
+	inline void Release(ARGB* tile) { _free.push_back(tile); }
+
+	// Bytes reserved by the Pool (used and free Tiles)
+	inline size_t Capacity() const { return _blocks.size() * TILE_POOL_BLOCK * TILE_PIXELS * sizeof(ARGB); }
+};
+
+//
+// Canvas
+//
+// Sparse Background Pixel Buffer: The area is split into Tiles, only Tiles touched by drawing are allocated
+// Every other Tile is implicitly filled with the Background Color, so Memory scales with the Trail, not the Canvas
+// Modified Tiles are marked dirty and uploaded one by one (only those) to the Background Texture
+//
+class Canvas {
+private:
+	int _width, _height;
+	int _tilesX, _tilesY;
+	ARGB _clearColor;
+	TilePool _pool;
+	std::vector<ARGB*> _tiles;
+	std::vector<bool> _dirty;
+	std::vector<size_t> _dirtyTiles;
+	std::vector<size_t> _usedTiles;
+	std::vector<byte> _blank;
+	std::vector<ARGB> _clearTile;
+
+public:
+	Canvas() : _width(0), _height(0), _tilesX(0), _tilesY(0), _clearColor(ToARGB(COLOR_WHITE)) {}
+	Canvas(const Canvas&) = delete;
+	Canvas& operator=(const Canvas&) = delete;
+
+	void Resize(int width, int height, ARGB clearColor);
+	void Clear();
+	void MarkAllDirty();
+	void Fade(JobSystem& jobs, byte amount);
+	void Upload(SDL_Texture* texture);
+
+	inline int Width() const { return _width; }
+	inline int Height() const { return _height; }
+	inline size_t TileCount() const { return _usedTiles.size(); }
+	inline size_t MemoryUsage() const { return _pool.Capacity(); }
+
+	void Set(int x, int y, ARGB color);
+	template <class F>
+	void ForSpan(int x, int y, size_t count, const F& func);
+
+	~Canvas() = default;
+
+private:
+	ARGB* Tile(size_t index);
+	inline void MarkDirty(size_t index) { if (!_dirty[index]) { _dirty[index] = true; _dirtyTiles.push_back(index); } }
+};
+
+//
+// Call func(pixels, offset, length) for every piece of the horizontal Span [x, x + count) in row y
+// The Span is split at Tile boundaries ("offset" is the position of the piece inside the Span),
+// Tiles are allocated on demand and marked dirty. The Span must be inside the Canvas
+//
+template <class F>
+void Canvas::ForSpan(int x, int y, size_t count, const F& func) {
+	const size_t row = (size_t)(y >> TILE_SHIFT) * _tilesX;
+	const size_t localY = (size_t)(y & (TILE_SIZE - 1)) * TILE_SIZE;
+	size_t offset = 0;
+	while (offset < count) {
+		const int tileX = x >> TILE_SHIFT, localX = x & (TILE_SIZE - 1);
+		const size_t length = std::min(count - offset, (size_t)(TILE_SIZE - localX));
+		func(Tile(row + tileX) + localY + localX, offset, length);
+		offset += length;
+		x += (int)length;
+	}
+}
+
+}
+
+#endif // FOURIER_CANVAS_H
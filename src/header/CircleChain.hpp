@@ -0,0 +1,74 @@
+
+#ifndef FOURIER_CIRCLECHAIN_H
+#define FOURIER_CIRCLECHAIN_H
+
+#include "Circle.hpp"
+#include <array>
+#include <utility>
+#include <cstddef>
+
+namespace Fourier {
+
+//
+// Parameters of one Epicycle (a literal type, so whole Presets can be constexpr)
+//
+struct Epicycle {
+	int Frequency;
+	float Radius;
+	float AngleOffset;
+};
+
+template <size_t N>
+using Preset = std::array<Epicycle, N>;
+
+//
+// CircleChain
+//
+// Fixed number of chained Circles in a std::array: No heap allocation, and with N known at compile-time
+// the Transformation (see Transformations::Transform) is fully unrolled
+// Provides data() and size() like a std::vector<Circle>, so it is drawn through the same Graphics::Draw
+//
+template <size_t N>
+class CircleChain {
+	static_assert(N > 0, "A CircleChain needs at least one Circle");
+
+private:
+	std::array<Circle, N> _circles;
+	Vec2 _sumDot;
+
+public:
+	CircleChain(const Preset<N>& preset, const Pixel& center)
+		: _circles(Create(preset, center, std::make_index_sequence<N>())), _sumDot(center.X, center.Y) {}
+
+	inline Circle& operator[](size_t i) { return _circles[i]; }
+	inline const Circle& operator[](size_t i) const { return _circles[i]; }
+	inline const Circle* data() const { return _circles.data(); }
+	static constexpr size_t size() { return N; }
+
+	// Sum of all Epicycles (the exact CycleDot of the last Circle, set by the Transformation)
+	inline const Vec2& SumDot() const { return _sumDot; }
+	inline void SetSumDot(const Vec2& sumDot) { _sumDot = sumDot; }
+
+private:
+	template <size_t... I>
+	static std::array<Circle, N> Create(const Preset<N>& preset, const Pixel& center, std::index_sequence<I...>) {
+		return { { Circle(center, preset[I].Radius, preset[I].AngleOffset, preset[I].Frequency)... } };
+	}
+};
+
+//
+// Presets
+//
+// Default Scene shown, if no Image or Coefficient File was loaded
+constexpr Preset<6> PRESET_DEFAULT = { {
+	{ 1, 120.0f, 0.0f },
+	{ 2, 100.0f, 45.0f },
+	{ 4, 80.0f, 20.0f },
+	{ 6, 60.0f, 0.0f },
+	{ 8, 40.0f, 90.0f },
+	{ 10, 20.0f, 0.0f }
+} };
+
+}
+
+#endif // FOURIER_CIRCLECHAIN_H
@@ -0,0 +1,74 @@
+
+#ifndef FOURIER_COEFFICIENTFILE_H
+#define FOURIER_COEFFICIENTFILE_H
+
+#include "Exception.hpp"
+#include "Spectrum.hpp"
+#include <cstdint>
+#include <string>
+
+namespace Fourier {
+
+//
+// Binary Coefficient File Header (Version 1, little-endian, 64 Bytes)
+//
+// The Header is followed by the three Coefficient arrays in SoA layout (Frequency, Amplitude, Phase),
+// each starting at a 64-Byte aligned offset. Frequencies are always float32,
+// Amplitudes and Phases are float32 or float16 (COEFFICIENT_FLAG_HALF)
+//
+struct CoefficientHeader {
+	char Magic[4];
+	uint32_t Version;
+	uint32_t Flags;
+	uint32_t Reserved;
+	uint64_t Count;
+	uint64_t FrequencyOffset;
+	uint64_t AmplitudeOffset;
+	uint64_t PhaseOffset;
+	uint64_t FileSize;
+	uint64_t Padding;
+};
+static_assert(sizeof(CoefficientHeader) == 64, "CoefficientHeader must be 64 Bytes");
+
+static const char COEFFICIENT_MAGIC[4] = { 'F', 'C', 'O', 'F' };
+static const uint32_t COEFFICIENT_VERSION = 1;
+static const uint32_t COEFFICIENT_FLAG_HALF = 1;
+static const uint64_t COEFFICIENT_ALIGNMENT = 64;
+
+//
+// CoefficientFile
+//
+// Read-only memory-mapping of a Coefficient File: No parsing and no copying,
+// the SpectrumView points directly into the mapped pages (only touched pages are ever loaded)
+//
+class CoefficientFile {
+private:
+	const void* _data;
+	size_t _size;
+	SpectrumView _view;
+#ifdef _WIN32
+	void* _file;
+	void* _mapping;
+#else
+	int _file;
+#endif
+
+public:
+	CoefficientFile(const std::string& file);
+	CoefficientFile(const CoefficientFile&) = delete;
+	CoefficientFile& operator=(const CoefficientFile&) = delete;
+
+	inline const SpectrumView& View() const { return _view; }
+	static void Save(const SpectrumView& spectrum, const std::string& file, bool half);
+
+	~CoefficientFile();
+
+private:
+	void Map(const std::string& file);
+	void Validate(const std::string& file);
+	void Unmap();
+};
+
+}
+
+#endif // FOURIER_COEFFICIENTFILE_H
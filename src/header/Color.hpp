@@ -3,6 +3,7 @@
 #define FOURIER_COLOR_H
 
 #include "Settings.hpp"
+#include <utility>
 
 // Predefined Colors
 #define COLOR_RED			Color(179, 0, 0)
@@ -65,6 +66,14 @@ public:
 // (Could be "byte", but that would likely crash the arithmetic operators)
 typedef _Color<ushort> Color;
 
+// Packed 32-Bit Pixel in the SDL_PIXELFORMAT_ARGB8888 layout (0xAARRGGBB)
+// Used for all CPU-side Pixel Buffers, so one Pixel is written with a single store
+typedef uint ARGB;
+
+inline ARGB ToARGB(const Color& c) {
+	return ((ARGB)(c.a & 0xFF) << 24) | ((ARGB)(c.r & 0xFF) << 16) | ((ARGB)(c.g & 0xFF) << 8) | (ARGB)(c.b & 0xFF);
+}
+
 }
 
 #endif // FOURIER_COLOR_H
@@ -4,6 +4,9 @@
 
 #include "Circle.hpp"
 #include "Color.hpp"
+#include "PixelKernels.hpp"
+#include "JobSystem.hpp"
+#include "Canvas.hpp"
 #include <math.h>
 #include <vector>
 #include <string>
@@ -15,34 +18,51 @@ namespace Fourier {
 
 class Graphics {
 private:
+	JobSystem& _jobs;
 	std::shared_ptr<SDL_Renderer> _renderer;
 	std::shared_ptr<SDL_Texture> _background;
+	std::shared_ptr<SDL_Texture> _guiLayer;
 	int _bgWidth, _bgHeight;
 	bool _solidDrawing;
+	float _trailWidth;
+	std::vector<byte> _coverage;
+	std::vector<SDL_Rect> _spans;
+	std::vector<int> _extents;
 
 public:
-	Graphics(std::shared_ptr<SDL_Renderer> renderer) : _renderer(renderer), _bgWidth(0), _bgHeight(0), _solidDrawing(false) {}
+	Graphics(std::shared_ptr<SDL_Renderer> renderer, JobSystem& jobs) : _jobs(jobs), _renderer(renderer), _bgWidth(0), _bgHeight(0), _solidDrawing(false), _trailWidth(TRAIL_WIDTH) {}
 	Graphics(const Graphics&) = delete;
 	Graphics& operator=(const Graphics&) = delete;
 
-	void Draw(const std::vector<Circle>& circles, std::vector<byte>& backgroundPixels, const Pixel& lastSumDot);
-	void UpdateBackground(std::shared_ptr<SDL_Texture> background, int bgWidth, int bgHeight);
+	void Draw(const Circle* circles, size_t count, Canvas& canvas, const Vec2& sumDot, const Vec2& lastSumDot);
+	// Any contiguous Circle container (std::vector<Circle>, CircleChain<N>)
+	template <class C>
+	inline void Draw(const C& circles, Canvas& canvas, const Vec2& sumDot, const Vec2& lastSumDot) { Draw(circles.data(), circles.size(), canvas, sumDot, lastSumDot); }
+	void UpdateBackground(std::shared_ptr<SDL_Texture> background, int bgWidth, int bgHeight, ARGB clearColor);
+	void UpdateGuiLayer(std::shared_ptr<SDL_Texture> guiLayer);
+	inline void SetTrailWidth(float width) { _trailWidth = width; }
 
 	~Graphics() = default;
 
 private:
 	void DrawLine_N(const Pixel& from, const Pixel& to);
 	void DrawLine_B(const Pixel& from, const Pixel& to);
-	void DrawLine_B_Background(std::vector<byte>& backgroundPixels, const Pixel& from, const Pixel& to, const Color& color);
+	void DrawLine_AA_Background(Canvas& canvas, const Vec2& from, const Vec2& to, const Color& color);
+	void DrawThickLine(const Pixel& from, const Pixel& to, float width);
 	void DrawCircle(ushort radius, const Pixel& center);
 	void DrawDot(ushort radius, const Pixel& center);
+	void FillRing(const Pixel& center, int outer, int inner);
+	void FillConvex(const Vec2* points, size_t count);
 	void DrawSinWave(const Pixel& start, const Pixel& offset, float heightScaling = 1.0f, float frequency = 1.0f, float waveCount = 1.0f);
 
 	inline void SetSolidDrawing(bool sd) { _solidDrawing = sd; }
 	void SetColor(const Color& color);
 	void SetPixel(const Pixel& pixel);
 	void SetPixel(const ushort& x, const ushort& y);
-	void SetBackgroundPixel(std::vector<byte>& backgroundPixels, ushort x, ushort y, const Color& color);
+
+	// Collect horizontal Spans (1 Pixel high Rects) and submit all of them with one Fill call
+	inline void AddSpan(int x, int y, int length) { if (length > 0) _spans.push_back({ x, y, length, 1 }); }
+	void FlushSpans();
 };
 
 }
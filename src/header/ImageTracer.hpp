@@ -0,0 +1,56 @@
+
+#ifndef FOURIER_IMAGETRACER_H
+#define FOURIER_IMAGETRACER_H
+
+#include "Exception.hpp"
+#include "KdTree.hpp"
+#include "JobSystem.hpp"
+#include "Vec2.hpp"
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+namespace Fourier {
+
+//
+// ImageTracer
+//
+// Turns an Image (PNG, JPG, ... anything SDL_image can load) into one closed Path:
+// Canny Edge-Detection (parallel in Row-Bands on the JobSystem) -> Contour-Tracing -> Contours ordered by a nearest-neighbour Tour
+// The resulting Path can be transformed into Epicycles via Transformations::FFT
+//
+class ImageTracer {
+private:
+	JobSystem& _jobs;
+	int _width, _height;
+	std::vector<float> _gray;
+	std::vector<float> _buffer;
+	std::vector<byte> _direction;
+	std::vector<byte> _edges;
+
+public:
+	ImageTracer(JobSystem& jobs) : _jobs(jobs), _width(0), _height(0) {}
+	ImageTracer(const ImageTracer&) = delete;
+	ImageTracer& operator=(const ImageTracer&) = delete;
+
+	std::vector<Vec2> Trace(const std::string& file);
+	static void Normalize(std::vector<Vec2>& path, float size);
+
+	~ImageTracer() = default;
+
+private:
+	void LoadGrayscale(const std::string& file);
+	void Blur();
+	void Sobel();
+	float Suppress();
+	void Hysteresis(float low, float high);
+	std::vector<std::vector<Vec2>> TraceContours();
+	std::vector<Vec2> OrderContours(const std::vector<std::vector<Vec2>>& contours);
+	std::vector<Vec2> Follow(int x, int y);
+	void ParallelRows(const std::function<void(int, int)>& rows);
+};
+
+}
+
+#endif // FOURIER_IMAGETRACER_H
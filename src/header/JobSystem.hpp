@@ -0,0 +1,137 @@
+
+#ifndef FOURIER_JOBSYSTEM_H
+#define FOURIER_JOBSYSTEM_H
+
+#include "Settings.hpp"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace Fourier {
+
+//
+// JobSystem
+//
+// Work-stealing Scheduler with one Job-Queue per Thread (sized to the hardware concurrency)
+// Threads take their own Jobs from the back (LIFO, cache-friendly) and steal from the front of other Queues
+// Jobs are small PODs (function pointer + pointer to the callable + range), so submitting never allocates
+// Waiting Threads help executing Jobs instead of blocking, so nested ParallelFor calls don't dead-lock
+// (Threads other than the Workers share one Queue and only help with the Jobs they are waiting for)
+//
+class JobSystem {
+public:
+	struct Job {
+		void (*Function)(const void* data, size_t begin, size_t end);
+		const void* Data;
+		size_t Begin, End;
+		std::atomic<size_t>* Pending;
+	};
+
+private:
+	struct Queue {
+		std::mutex Lock;
+		std::vector<Job> Jobs;
+		size_t Head = 0, Tail = 0;
+	};
+
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::vector<std::thread> _workers;
+	std::mutex _sleepLock;
+	std::condition_variable _wake;
+	std::atomic<size_t> _queued;
+	std::atomic<bool> _stop;
+
+public:
+	JobSystem(size_t threads = std::thread::hardware_concurrency());
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Number of Threads executing Jobs (Workers + the waiting Thread)
+	inline size_t Size() const { return _workers.size() + 1; }
+
+	template <class F>
+	void ParallelFor(size_t begin, size_t end, size_t grain, const F& func);
+	void Submit(const Job& job);
+	void Wait(std::atomic<size_t>& pending);
+
+	~JobSystem();
+
+private:
+	bool Push(const Job& job);
+	bool Pop(Job& job);
+	bool PopGroup(Job& job, const std::atomic<size_t>& pending);
+	bool Steal(Job& job);
+	void Execute(const Job& job);
+	void Wake();
+	void WorkerLoop();
+};
+
+//
+// TaskGroup
+//
+// Independent Tasks that are waited for together
+// The callables are referenced, not copied: They must stay alive until Wait() returned
+// (Temporaries are rejected at compile-time, they would be gone before the Task runs)
+//
+class TaskGroup {
+private:
+	JobSystem& _jobs;
+	std::atomic<size_t> _pending;
+
+public:
+	TaskGroup(JobSystem& jobs) : _jobs(jobs), _pending(0) {}
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	template <class F>
+	void Run(const F& func) {
+		_pending++;
+		_jobs.Submit({ [](const void* data, size_t, size_t) { (*(const F*)data)(); }, &func, 0, 0, &_pending });
+	}
+	template <class F>
+	void Run(const F&&) = delete;
+	inline void Wait() { _jobs.Wait(_pending); }
+
+	~TaskGroup() { Wait(); }
+};
+
+//
+// Split [begin, end) into Chunks of at least "grain" elements and call func(chunkBegin, chunkEnd) in parallel
+// The calling Thread works on the first Chunk itself and helps with the rest until all are done
+//
+template <class F>
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grain, const F& func) {
+	if (end <= begin)
+		return;
+
+	// Not more than a few Chunks per Thread (more would only add scheduling overhead)
+	const size_t count = end - begin;
+	grain = std::max(std::max(grain, (size_t)1), count / (Size() * 8));
+	if (count <= grain || _workers.empty()) {
+		func(begin, end);
+		return;
+	}
+
+	std::atomic<size_t> pending(0);
+	const auto call = [](const void* data, size_t b, size_t e) { (*(const F*)data)(b, e); };
+	for (size_t b = begin + grain; b < end; b += grain) {
+		pending++;
+		if (!Push({ call, &func, b, std::min(b + grain, end), &pending })) {
+			// Queue is full: No reason to wait for anybody else
+			pending--;
+			func(b, std::min(b + grain, end));
+		}
+	}
+	Wake();
+
+	func(begin, begin + grain);
+	Wait(pending);
+}
+
+}
+
+#endif // FOURIER_JOBSYSTEM_H
@@ -0,0 +1,46 @@
+
+#ifndef FOURIER_KDTREE_H
+#define FOURIER_KDTREE_H
+
+#include "Vec2.hpp"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+namespace Fourier {
+
+//
+// KdTree
+//
+// Static 2D k-d tree for nearest-neighbour queries, with support for removing Points
+// The tree is stored implicitly: The node of a range [lo, hi) is its median slot (lo + hi) / 2
+// and each node counts the Points still alive in its subtree, so emptied subtrees are skipped
+//
+class KdTree {
+private:
+	std::vector<Vec2> _points;
+	std::vector<uint> _ids;
+	std::vector<uint> _slots;
+	std::vector<uint> _alive;
+	std::vector<bool> _removed;
+
+public:
+	KdTree(const std::vector<Vec2>& points);
+	KdTree(const KdTree&) = delete;
+	KdTree& operator=(const KdTree&) = delete;
+
+	int Nearest(const Vec2& query) const;
+	void Remove(uint id);
+	inline size_t Size() const { return _alive.empty() ? 0 : _alive[_alive.size() / 2]; }
+
+	~KdTree() = default;
+
+private:
+	void Build(uint lo, uint hi, uint depth);
+	void Nearest(const Vec2& query, uint lo, uint hi, uint depth, int& best, float& bestDistance) const;
+};
+
+}
+
+#endif // FOURIER_KDTREE_H
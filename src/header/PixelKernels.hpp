@@ -0,0 +1,58 @@
+
+#ifndef FOURIER_PIXELKERNELS_H
+#define FOURIER_PIXELKERNELS_H
+
+#include "Color.hpp"
+#include <vector>
+#include <cstddef>
+#include <cmath>
+
+namespace Fourier {
+
+//
+// Pixel Kernels
+//
+// Span operations on packed ARGB Pixel Buffers (SSE2 / AVX2 with a scalar fallback)
+// All Kernels work on "count" consecutive Pixels, so a horizontal Span is just (row + x, length)
+// and a whole Buffer is (buffer.data(), buffer.size())
+//
+namespace Kernels {
+
+// Set every Pixel of the Span to the same value
+void Fill(ARGB* dst, size_t count, ARGB value);
+
+// Blend a constant Color over the Span: dst = dst + (color - dst) * alpha / 255
+void Blend(ARGB* dst, size_t count, ARGB color, byte alpha);
+
+// Move every Pixel of the Span closer to the target Color by "amount" / 256 of the difference
+// (Rounded towards the target, so repeated fading always ends exactly at the target Color)
+void Fade(ARGB* dst, size_t count, ARGB target, byte amount);
+
+// Blend a constant Color over the Span, with a separate alpha (coverage) value for every Pixel
+void BlendMask(ARGB* dst, const byte* mask, size_t count, ARGB color);
+
+// Line-Segment starting at (X, Y) with direction (DX, DY), prepared for the Coverage calculation
+struct Segment {
+	float X, Y, DX, DY;
+	float InvLength, Length2, HalfWidth;
+
+	Segment(float x0, float y0, float x1, float y1, float width)
+		: X(x0), Y(y0), DX(x1 - x0), DY(y1 - y0), HalfWidth(width * 0.5f) {
+		Length2 = (DX * DX) + (DY * DY);
+		InvLength = (Length2 > 0.0f) ? 1.0f / std::sqrt(Length2) : 0.0f;
+	}
+};
+
+// Coverage [0, 255] of the Pixels (px + i, py) by a Segment (px, py are the Pixel-Centers)
+// Based on the distance of each Pixel-Center to the Line, with a one Pixel wide anti-aliased edge
+// Only Pixels projecting onto the Segment (0 <= t < 1) are covered, so connected Segments don't overlap
+void Coverage(byte* dst, size_t count, float px, float py, const Segment& segment);
+
+// Clear a whole Pixel Buffer
+inline void Clear(std::vector<ARGB>& buffer, ARGB value) { Fill(buffer.data(), buffer.size(), value); }
+
+}
+
+}
+
+#endif // FOURIER_PIXELKERNELS_H
@@ -0,0 +1,49 @@
+
+#ifndef FOURIER_SCENE_H
+#define FOURIER_SCENE_H
+
+#include "Circle.hpp"
+#include "Spectrum.hpp"
+#include "CoefficientFile.hpp"
+#include "Trajectory.hpp"
+#include <vector>
+#include <memory>
+
+namespace Fourier {
+
+//
+// Scene
+//
+// Complete Epicycle configuration, published as immutable Snapshot to the Render-Loop
+// Owns the memory of its Coefficients (a Spectrum or a mapped CoefficientFile), so the View
+// stays valid as long as the Scene lives
+//
+struct Scene {
+public:
+	Spectrum Coefficients;
+	std::unique_ptr<CoefficientFile> File;
+	SpectrumView View;
+	Pixel Center;
+	float AngleStep;
+	// Initial state of the displayed Circles (the largest Coefficients) and the index of their Coefficient
+	std::vector<Circle> Circles;
+	std::vector<size_t> CircleCoefficients;
+	// Path of the Sum over one Period (one Sample per Frame)
+	Trajectory Path;
+	// Copy of the previous Scene with edited Circles: The animation continues instead of starting over
+	bool Edited = false;
+
+public:
+	Scene(Spectrum&& coefficients, const Pixel& center, float angleStep)
+		: Coefficients(std::move(coefficients)), View(Coefficients.View()), Center(center), AngleStep(angleStep) {}
+	Scene(std::unique_ptr<CoefficientFile>&& file, const Pixel& center, float angleStep)
+		: File(std::move(file)), View(File->View()), Center(center), AngleStep(angleStep) {}
+	Scene(const Scene&) = delete;
+	Scene& operator=(const Scene&) = delete;
+
+	~Scene() = default;
+};
+
+}
+
+#endif // FOURIER_SCENE_H
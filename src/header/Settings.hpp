@@ -4,9 +4,11 @@
 
 #ifdef _WIN32
 #include <SDL.h>
+#include <SDL_image.h>
 #undef main
-#elif
+#else
 #include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
 #endif
 
 #include "KW_gui.h"
@@ -18,12 +20,37 @@
 
 #ifdef _WIN32
 #define BASE_PATH "C:/Users/PeterUser/Documents/GitHub/Fourier/Fourier/resources/"
-#elif
+#else
 #define BASE_PATH "/Users/peter/Documents/github/C++/Fourier/libs/KiWi/resources/"
 #endif
 
 #define FPS 60
 
+// Per-Frame decay of the Background Trail towards the Background Color
+// (0 = Trail stays forever, 1 - 255 = Amount of fading per Frame, in 1/256 steps)
+#define TRAIL_FADE 0
+// Width of the anti-aliased Background Trail in Pixels
+#define TRAIL_WIDTH 2.0f
+
+// Image-to-Epicycles: Max. FFT size, max. number of displayed Circles and Frames for one full Period
+#define IMAGE_FFT_SIZE 65536
+#define IMAGE_CIRCLES 256
+#define IMAGE_PERIOD_FRAMES 1800
+// Rows per Job for the parallel Image processing
+#define IMAGE_BAND_ROWS 16
+
+// File extension of (memory-mapped) Coefficient Files
+#define SCENE_EXTENSION ".fcoef"
+
+// SIMD Instruction-Set used by the Pixel-Kernels (Scalar fallback, if none is available)
+// MSVC only defines __AVX2__ with /arch:AVX2, but SSE2 is always available on x64
+#if defined(__AVX2__)
+#define FOURIER_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FOURIER_SSE2
+#endif
+
 namespace Fourier {
 
 typedef unsigned short ushort;
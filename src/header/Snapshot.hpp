@@ -0,0 +1,140 @@
+
+#ifndef FOURIER_SNAPSHOT_H
+#define FOURIER_SNAPSHOT_H
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace Fourier {
+
+//
+// Snapshot
+//
+// RCU-style publication of immutable values: Writers publish a complete new value with an atomic
+// pointer swap, the old one is retired and only deleted once the Reader announced that it moved past it
+//
+// Reader side (one Thread, e.g. the Render-Loop): Never blocks and never copies
+//   if (snapshot.Epoch() != epoch) { value = snapshot.Acquire(epoch); ...; snapshot.Quiescent(epoch); }
+//   "value" stays valid until the Reader calls Quiescent() with a newer epoch
+// Writer side (any Thread): Publish(), Replace(), Pin() and Unpin() are serialized by a Mutex
+// Pinned values stay alive without holding the Mutex, so slow work (e.g. writing a File) never blocks other Writers
+//
+template <class T>
+class Snapshot {
+private:
+	std::atomic<const T*> _current;
+	std::atomic<uint64_t> _epoch;
+	std::atomic<uint64_t> _readerEpoch;
+	std::mutex _writeLock;
+	// Retired values with the epoch of their replacement
+	std::vector<std::pair<uint64_t, const T*>> _retired;
+	// Epochs of the pinned values (one entry per Pin)
+	std::vector<uint64_t> _pins;
+
+public:
+	Snapshot() : _current(nullptr), _epoch(0), _readerEpoch(0) {}
+	Snapshot(const Snapshot&) = delete;
+	Snapshot& operator=(const Snapshot&) = delete;
+
+	//
+	// Replace the current value (the old one is deleted later, when the Reader doesn't use it anymore)
+	//
+	void Publish(std::unique_ptr<T> value) {
+		std::lock_guard<std::mutex> lock(_writeLock);
+		Swap(std::move(value));
+	}
+
+	//
+	// Replace the value of "epoch" (e.g. with a modified copy of it)
+	// Returns false without publishing, if another Writer published a newer value meanwhile
+	//
+	bool Replace(uint64_t epoch, std::unique_ptr<T> value) {
+		std::lock_guard<std::mutex> lock(_writeLock);
+		if (_epoch.load() != epoch)
+			return false;
+		Swap(std::move(value));
+		return true;
+	}
+
+	//
+	// Get the current value (nullptr if nothing was published yet) and keep it alive until Unpin(epoch)
+	//
+	const T* Pin(uint64_t& epoch) {
+		std::lock_guard<std::mutex> lock(_writeLock);
+		epoch = _epoch.load();
+		const T* value = _current.load();
+		if (value != nullptr)
+			_pins.push_back(epoch);
+		return value;
+	}
+
+	void Unpin(uint64_t epoch) {
+		std::lock_guard<std::mutex> lock(_writeLock);
+		const auto pin = std::find(_pins.begin(), _pins.end(), epoch);
+		if (pin != _pins.end())
+			_pins.erase(pin);
+		Reclaim();
+	}
+
+	// Number of Publish() calls so far (0 = no value yet)
+	inline uint64_t Epoch() const { return _epoch.load(); }
+
+	//
+	// Reader: Get the current value and the epoch it belongs to
+	//
+	const T* Acquire(uint64_t& epoch) const {
+		epoch = _epoch.load();
+		return _current.load();
+	}
+
+	//
+	// Reader: Announce that no value older than "epoch" is referenced anymore
+	// Retired values are deleted right away, if no Writer holds the lock (the Reader never waits)
+	//
+	void Quiescent(uint64_t epoch) {
+		_readerEpoch.store(epoch);
+		std::unique_lock<std::mutex> lock(_writeLock, std::try_to_lock);
+		if (lock.owns_lock())
+			Reclaim();
+	}
+
+	~Snapshot() {
+		for (auto& retired : _retired)
+			delete retired.second;
+		delete _current.load();
+	}
+
+private:
+	// Writer Lock must be held
+	void Swap(std::unique_ptr<T> value) {
+		const T* old = _current.exchange(value.release());
+		// Incremented after the swap: A Reader seeing the new epoch is guaranteed to get the new value
+		const uint64_t epoch = _epoch.fetch_add(1) + 1;
+		if (old != nullptr)
+			_retired.emplace_back(epoch, old);
+		Reclaim();
+	}
+
+	// Delete all retired values the Reader moved past and no Pin refers to (Writer Lock must be held)
+	// (A value pinned at epoch p is replaced at an epoch > p)
+	void Reclaim() {
+		const uint64_t readerEpoch = _readerEpoch.load();
+		const uint64_t oldestPin = _pins.empty() ? UINT64_MAX : *std::min_element(_pins.begin(), _pins.end());
+		size_t kept = 0;
+		for (auto& retired : _retired) {
+			if (retired.first <= readerEpoch && retired.first <= oldestPin)
+				delete retired.second;
+			else
+				_retired[kept++] = retired;
+		}
+		_retired.resize(kept);
+	}
+};
+
+}
+
+#endif // FOURIER_SNAPSHOT_H
@@ -0,0 +1,145 @@
+
+#ifndef FOURIER_SPECTRUM_H
+#define FOURIER_SPECTRUM_H
+
+#include "Settings.hpp"
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Fourier {
+
+//
+// IEEE 754 half-precision (float16) conversion, used for quantized Coefficients
+// FloatToHalf rounds to nearest-even, out of range values become infinity
+//
+inline float HalfToFloat(ushort h) {
+	const uint sign = (uint)(h & 0x8000) << 16;
+	uint exponent = (h >> 10) & 0x1F;
+	uint mantissa = h & 0x3FF;
+	uint bits;
+	if (exponent == 0x1F) {
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else if (exponent != 0) {
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	}
+	else if (mantissa != 0) {
+		// Subnormal: Normalize the mantissa
+		exponent = 113;
+		while ((mantissa & 0x400) == 0) { mantissa <<= 1; exponent--; }
+		bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+	}
+	else {
+		bits = sign;
+	}
+	float f;
+	std::memcpy(&f, &bits, sizeof(float));
+	return f;
+}
+
+inline ushort FloatToHalf(float f) {
+	uint bits;
+	std::memcpy(&bits, &f, sizeof(float));
+	const ushort sign = (ushort)((bits >> 16) & 0x8000);
+	const int exponent = (int)((bits >> 23) & 0xFF) - 112;
+	uint mantissa = bits & 0x7FFFFF;
+	if (((bits >> 23) & 0xFF) == 0xFF)
+		return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+	if (exponent >= 0x1F)
+		return sign | 0x7C00;
+	if (exponent <= 0) {
+		// Subnormal or zero
+		if (exponent < -10)
+			return sign;
+		mantissa |= 0x800000;
+		const uint shift = 14 - exponent;
+		uint half = mantissa >> shift;
+		const uint rest = mantissa & ((1u << shift) - 1), midpoint = 1u << (shift - 1);
+		if (rest > midpoint || (rest == midpoint && (half & 1)))
+			half++;
+		return sign | (ushort)half;
+	}
+	uint half = ((uint)exponent << 10) | (mantissa >> 13);
+	const uint rest = mantissa & 0x1FFF;
+	if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+		half++;
+	return sign | (ushort)half;
+}
+
+//
+// SpectrumView
+//
+// Read-only, non-owning view on Coefficients in SoA layout (Memory of a Spectrum or a mapped CoefficientFile)
+// Frequencies are always 32-Bit floats, Amplitudes and Phases can be quantized to float16
+//
+struct SpectrumView {
+public:
+	size_t Count;
+	bool Half;
+	const float* Frequency;
+	const void* Amplitude;
+	const void* Phase;
+
+public:
+	SpectrumView() : Count(0), Half(false), Frequency(nullptr), Amplitude(nullptr), Phase(nullptr) {}
+	SpectrumView(size_t count, bool half, const float* frequency, const void* amplitude, const void* phase)
+		: Count(count), Half(half), Frequency(frequency), Amplitude(amplitude), Phase(phase) {}
+
+	inline float GetFrequency(size_t i) const { return Frequency[i]; }
+	inline float GetAmplitude(size_t i) const { return Half ? HalfToFloat(((const ushort*)Amplitude)[i]) : ((const float*)Amplitude)[i]; }
+	inline float GetPhase(size_t i) const { return Half ? HalfToFloat(((const ushort*)Phase)[i]) : ((const float*)Phase)[i]; }
+};
+
+//
+// Spectrum
+//
+// Fourier Coefficients of a closed Path, stored as Structure-of-Arrays (one Epicycle per index)
+// Frequency: Full rotations per Period (negative = clockwise)
+// Amplitude: Radius of the Epicycle in Pixels
+// Phase:     Angle-Offset of the Epicycle in Degrees
+//
+struct Spectrum {
+public:
+	std::vector<float> Frequency;
+	std::vector<float> Amplitude;
+	std::vector<float> Phase;
+
+public:
+	size_t Size() const { return Frequency.size(); }
+	SpectrumView View() const { return SpectrumView(Size(), false, Frequency.data(), Amplitude.data(), Phase.data()); }
+
+	void Add(float frequency, float amplitude, float phase) {
+		Frequency.push_back(frequency);
+		Amplitude.push_back(amplitude);
+		Phase.push_back(phase);
+	}
+
+	//
+	// Sort all Coefficients by Amplitude (largest first)
+	// Cutting off the Spectrum after N Coefficients then keeps the N most important Epicycles
+	//
+	void SortByAmplitude() {
+		std::vector<size_t> order(Size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return Amplitude[a] > Amplitude[b]; });
+
+		Spectrum sorted;
+		sorted.Reserve(Size());
+		for (size_t i : order)
+			sorted.Add(Frequency[i], Amplitude[i], Phase[i]);
+		*this = std::move(sorted);
+	}
+
+	void Reserve(size_t size) {
+		Frequency.reserve(size);
+		Amplitude.reserve(size);
+		Phase.reserve(size);
+	}
+};
+
+}
+
+#endif // FOURIER_SPECTRUM_H
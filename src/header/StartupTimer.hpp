@@ -0,0 +1,55 @@
+
+#ifndef FOURIER_STARTUPTIMER_H
+#define FOURIER_STARTUPTIMER_H
+
+#include "Settings.hpp"
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <iomanip>
+
+namespace Fourier {
+
+//
+// StartupTimer
+//
+// Measures the Startup phases from Application creation on (high-resolution SDL Performance-Counter)
+// Each Mark() closes the phase since the previous Mark, phases running on other Threads are added with their duration
+//
+class StartupTimer {
+private:
+	Uint64 _start, _last;
+	std::vector<std::pair<std::string, double>> _phases;
+
+public:
+	StartupTimer() : _start(SDL_GetPerformanceCounter()), _last(_start) {}
+
+	void Mark(const std::string& phase) {
+		const Uint64 now = SDL_GetPerformanceCounter();
+		_phases.emplace_back(phase, Milliseconds(now - _last));
+		_last = now;
+	}
+
+	// A phase measured somewhere else (e.g. on a loading Thread, overlapping the other phases)
+	inline void Add(const std::string& phase, double milliseconds) { _phases.emplace_back(phase, milliseconds); }
+
+	// Milliseconds since the Application was created
+	inline double Elapsed() const { return Since(_start); }
+	// Milliseconds since a Performance-Counter value
+	static double Since(Uint64 counter) { return Milliseconds(SDL_GetPerformanceCounter() - counter); }
+
+	void Report(std::ostream& out) const {
+		out << "Startup (ms):" << std::endl;
+		for (const auto& phase : _phases)
+			out << "  " << std::left << std::setw(24) << phase.first << std::right << std::fixed << std::setprecision(2) << std::setw(9) << phase.second << std::endl;
+		out << "  " << std::left << std::setw(24) << "Total" << std::right << std::setw(9) << Elapsed() << std::endl;
+	}
+
+private:
+	static double Milliseconds(Uint64 ticks) { return ticks * 1000.0 / SDL_GetPerformanceFrequency(); }
+};
+
+}
+
+#endif // FOURIER_STARTUPTIMER_H
@@ -0,0 +1,40 @@
+
+#ifndef FOURIER_TRAJECTORY_H
+#define FOURIER_TRAJECTORY_H
+
+#include "Vec2.hpp"
+#include "Spectrum.hpp"
+#include "JobSystem.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Fourier {
+
+//
+// Trajectory
+//
+// Cached Path of the Sum of all Epicycles over one full Period: "Size" Samples at the angles 360 * i / Size
+// Stored as Structure-of-Arrays (X and Y), so all Samples are processed in SIMD lanes
+//
+// Every Epicycle adds Amplitude * e^(i * (angle * Frequency + Phase)) to each Sample, so changing
+// one Epicycle only needs its old contribution subtracted and the new one added: O(Size) instead of O(Size * Count)
+//
+class Trajectory {
+private:
+	std::vector<float> _x, _y;
+
+public:
+	Trajectory() = default;
+
+	void Synthesize(const SpectrumView& spectrum, size_t size, JobSystem& jobs);
+	void Update(float frequency, float oldAmplitude, float oldPhase, float newAmplitude, float newPhase);
+	Vec2 Sample(float angle) const;
+
+	inline size_t Size() const { return _x.size(); }
+
+	~Trajectory() = default;
+};
+
+}
+
+#endif // FOURIER_TRAJECTORY_H
@@ -3,19 +3,73 @@
 #define FOURIER_TRANSFORMATIONS_H
 
 #include "Circle.hpp"
+#include "CircleChain.hpp"
+#include "Spectrum.hpp"
+#include "JobSystem.hpp"
 #include <cmath>
+#include <climits>
 #include <vector>
+#include <complex>
 
 namespace Fourier {
 	
 class Transformations {
+private:
+	JobSystem& _jobs;
+
 public:
+	Transformations(JobSystem& jobs) : _jobs(jobs) {}
+
 	void Transform(std::vector<Circle>& circles, float angle);
+	template <size_t N>
+	void Transform(CircleChain<N>& chain, float angle);
+
+	Spectrum FFT(const std::vector<Vec2>& path, size_t maxSize);
+	std::vector<Circle> ToCircles(const SpectrumView& spectrum, const Pixel& center, size_t count, std::vector<size_t>* coefficients = nullptr);
 
 private:
-	void Rotate(Circle& circle, float angle);
+	inline Vec2 Rotate(const Circle& circle, float angle);
+	inline void Chain(Circle& circle, Vec2& prevDot, float angle);
+	template <size_t N, size_t... I>
+	void Transform(CircleChain<N>& chain, float angle, std::index_sequence<I...>);
+	std::vector<Vec2> Resample(const std::vector<Vec2>& path, size_t size);
+	void FFT(std::vector<std::complex<double>>& values);
 };
 
+//
+// Get the Dot position on the Circle circumference (relative to its Center) based on the angle
+//
+Vec2 Transformations::Rotate(const Circle& circle, float angle) {
+	const float radius = circle.Radius;
+	const float ar = ((angle * circle.Frequency) + circle.AngleOffset) * (M_PI / 180);
+	return Vec2(radius * cos(ar), radius * sin(ar));
+}
+
+//
+// Center the Circle on the previous CycleDot and move "prevDot" on to its own CycleDot
+//
+void Transformations::Chain(Circle& circle, Vec2& prevDot, float angle) {
+	circle.Center = Pixel(prevDot.X + 0.5f, prevDot.Y + 0.5f);
+	prevDot += Rotate(circle, angle);
+	circle.CycleDot = Pixel(prevDot.X + 0.5f, prevDot.Y + 0.5f);
+}
+
+//
+// Same as Transform for a std::vector, but the Circle count is known at compile-time:
+// The fold-expression unrolls the whole Chain (no loop, no bounds, no heap access)
+//
+template <size_t N>
+void Transformations::Transform(CircleChain<N>& chain, float angle) {
+	Transform(chain, angle, std::make_index_sequence<N>());
+}
+
+template <size_t N, size_t... I>
+void Transformations::Transform(CircleChain<N>& chain, float angle, std::index_sequence<I...>) {
+	Vec2 prevDot(chain[0].Center.X, chain[0].Center.Y);
+	(Chain(chain[I], prevDot, angle), ...);
+	chain.SetSumDot(prevDot);
+}
+
 }
 
 #endif // FOURIER_TRANSFORMATIONS_H
@@ -4,27 +4,81 @@
 using namespace Fourier;
 
 Application::Application(std::string&& appName, uint&& windowWidth, uint&& windowHeight, std::string&& resourcePath)
-	: _appName(std::move(appName)), _windowWidth(std::move(windowWidth)), _windowHeight(std::move(windowHeight)),
-	_resourcePath(std::move(resourcePath)), _surface(nullptr), _font(nullptr), _actualWidth(0), _actualHeight(0) {}
+	: _appName(std::move(appName)), _resourcePath(std::move(resourcePath)), _windowWidth(std::move(windowWidth)), _windowHeight(std::move(windowHeight)),
+	_actualWidth(0), _actualHeight(0), _startWidth(0), _startHeight(0), _firstFrameShown(false), _startupReported(false), _sceneLoadTime(0.0),
+	_angle(0.0f), _dragCircle(-1), _editFinished(false), _surface(nullptr), _font(nullptr), _guiDirty(true) {}
 
 Application::Application(const std::string& appName, const uint& windowWidth, const uint& windowHeight, const std::string& resourcePath)
-	: _appName(appName), _windowWidth(windowWidth), _windowHeight(windowHeight), _resourcePath(resourcePath),
-	_surface(nullptr), _font(nullptr), _actualWidth(0), _actualHeight(0) {}
+	: _appName(appName), _resourcePath(resourcePath), _windowWidth(windowWidth), _windowHeight(windowHeight),
+	_actualWidth(0), _actualHeight(0), _startWidth(0), _startHeight(0), _firstFrameShown(false), _startupReported(false), _sceneLoadTime(0.0),
+	_angle(0.0f), _dragCircle(-1), _editFinished(false), _surface(nullptr), _font(nullptr), _guiDirty(true) {}
 
 //
-// Initializes the SDL and KiwiGUI Ressources
-// and also creats/shows the Apps main Window
+// Initializes the SDL Ressources and creats/shows the Apps main Window
+// The KiwiGUI Ressources are loaded in the background, the GUI shows up as soon as they are ready
 //
 bool Application::InitApplication() {
 	try {
-		// Initialize all SDL2 subsystems
-		if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
+		// Initialize only the Video subsystem (including Events), everything else is never used
+		// (Other subsystems can be added on demand with SDL_InitSubSystem)
+		if (SDL_Init(SDL_INIT_VIDEO) != 0)
 			throw FourierException("SDL Error on Init: " + std::string(SDL_GetError()));
+		// SDL_image initializes its Decoders lazily and not thread-safe: Do it here, before the
+		// GUI Ressources and Scenes are loaded on background Threads (failing only disables the format)
+		const int imageFormats = IMG_INIT_PNG | IMG_INIT_JPG;
+		if ((IMG_Init(imageFormats) & imageFormats) != imageFormats)
+			std::cout << "SDL_image Error on Init: " << SDL_GetError() << std::endl;
+		_startup.Mark("SDL Init");
 
 		SetupWindow();
+		_startup.Mark("Window");
+		SDL_GetWindowSize(_window.get(), &_startWidth, &_startHeight);
 		SetupSDL();
-		SetupKiwiGUI();
+		_startup.Mark("Renderer");
 
+		// Initialize the KiWi SDL2 Render Driver
+		// You can have multiple GUI instances in the same/different windows, based on the Render Driver
+		_driver = kiwi_make_shared(KW_CreateSDL2RenderDriver(_renderer.get(), _window.get()));
+		if (_driver == nullptr)
+			throw FourierException("KiWi GUI Error creating GUI Driver: " + std::string(SDL_GetError()));
+		_resources = std::async(std::launch::async, [this]() { return LoadGuiResources(); });
+
+		return true;
+	}
+	catch (const std::exception& ex) {
+		std::cout << ex.what() << std::endl;
+		return false;
+	}
+}
+
+//
+// Trace the Edges of an Image and use the Fourier Transform of the resulting Path as Scene
+// (Must be called after InitApplication, the Path is scaled to fit into the Window)
+//
+bool Application::LoadImage(const std::string& file) {
+	try {
+		const int width = _startWidth, height = _startHeight;
+		ImageTracer tracer(_jobs);
+		std::vector<Vec2> path = tracer.Trace(file);
+		ImageTracer::Normalize(path, std::min(width, height) * 0.6f);
+
+		Transformations transform(_jobs);
+		SetScene(std::make_unique<Scene>(transform.FFT(path, IMAGE_FFT_SIZE), Pixel(width / 2, height / 2), 360.0f / IMAGE_PERIOD_FRAMES));
+		return true;
+	}
+	catch (const std::exception& ex) {
+		std::cout << ex.what() << std::endl;
+		return false;
+	}
+}
+
+//
+// Memory-map a precomputed Coefficient File and use it as Scene (no parsing, no copy, no FFT)
+//
+bool Application::LoadScene(const std::string& file) {
+	try {
+		const int width = _startWidth, height = _startHeight;
+		SetScene(std::make_unique<Scene>(std::make_unique<CoefficientFile>(file), Pixel(width / 2, height / 2), 360.0f / IMAGE_PERIOD_FRAMES));
 		return true;
 	}
 	catch (const std::exception& ex) {
@@ -33,62 +87,182 @@ bool Application::InitApplication() {
 	}
 }
 
+//
+// Save the Coefficients of the current Scene (optionally quantized to float16)
+// The Scene is pinned while the File is written, so no other Thread waits for the disk
+//
+bool Application::SaveScene(const std::string& file, bool half) {
+	uint64_t epoch = 0;
+	const Scene* scene = _scene.Pin(epoch);
+	bool saved = false;
+	try {
+		if (scene == nullptr)
+			throw FourierException("No Scene to save: " + file);
+		CoefficientFile::Save(scene->View, file, half);
+		saved = true;
+	}
+	catch (const std::exception& ex) {
+		std::cout << ex.what() << std::endl;
+	}
+	if (scene != nullptr)
+		_scene.Unpin(epoch);
+	return saved;
+}
+
+//
+// Run a (Scene-)Loading task in the background, while the Main Loop already runs
+// Scenes are published as Snapshot, so the Main Loop picks them up as soon as they are ready
+//
+void Application::LoadAsync(std::function<void()> task) {
+	if (_loading.valid())
+		_loading.wait();
+	_loading = std::async(std::launch::async, [this, task]() {
+		const Uint64 start = SDL_GetPerformanceCounter();
+		task();
+		_sceneLoadTime = StartupTimer::Since(start);
+	});
+}
+
+//
+// Switch to a new Scene: Only the largest Coefficients are shown as Circles,
+// but the Sum (and the Trail) is always evaluated over all of them
+// The Path of the Sum is synthesized once with one Sample per Frame, so every Frame just reads it
+// The Scene is published as Snapshot, the Render-Loop picks it up with its next Frame
+// A Scene without visible Circles is rejected, so the previous Scene stays active
+//
+void Application::SetScene(std::unique_ptr<Scene> scene) {
+	Transformations transform(_jobs);
+	scene->Circles = transform.ToCircles(scene->View, scene->Center, IMAGE_CIRCLES, &scene->CircleCoefficients);
+	if (scene->Circles.empty())
+		throw FourierException("Scene Error (no Coefficient large enough to be shown)");
+	scene->Path.Synthesize(scene->View, std::max<size_t>(1, (size_t)std::lround(360.0f / scene->AngleStep)), _jobs);
+	_scene.Publish(std::move(scene));
+}
+
+//
+// Main Loop: Process SDL Events and the GUI, then call frame() to Draw (limited to FPS)
+// Returns false when the Application should quit, true when frame() returned false
+//
+template <class F>
+bool Application::MainLoop(Graphics& graphics, const F& frame) {
+	SDL_Event event;
+	// The first Frame is drawn right away (the unsigned difference also works, if the Ticks wrap around)
+	uint timeStamp_new = SDL_GetTicks(), timeStamp_old = timeStamp_new - (1000 / FPS + 1);
+	while (!SDL_QuitRequested()) {
+		// FPS Limiter (Nice, because it works without WAIT)
+		timeStamp_new = SDL_GetTicks();
+		if ((timeStamp_new - timeStamp_old) > (1000.0f / FPS)) {
+			timeStamp_old = timeStamp_new;
+
+			// Handle all Events in the queue
+			while (SDL_PollEvent(&event)) {
+				if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_RESIZED)
+					OnWindowResize(graphics);
+				else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+					OnRenderReset(graphics);
+				OnGuiEvent(event);
+				OnEditEvent(event);
+			}
+
+			// Create the GUI as soon as its Ressources are loaded
+			if (_gui == nullptr && _resources.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+				SetupKiwiGUI();
+
+			// Update and re-paint the GUI Layer, only if something changed
+			// (Otherwise the cached GUI Texture is just composited by Graphics::Draw)
+			if (_guiDirty && _gui != nullptr)
+				PaintGUI();
+
+			const bool next = frame();
+			UpdateStartup();
+			if (!next)
+				return true;
+		}
+	}
+	return false;
+}
+
+//
+// Constant rotation of "step" Degrees per Frame (one Degree, or less for Images with a lot more Circles)
+// Frequency 1 with one Degree == "6 sec. for one full rotation"
+//
+static float NextAngle(float angle, float step) {
+	angle += step;
+	return (angle >= 360.0f) ? angle - 360.0f : angle;
+}
+
 //
 // Run the Applications Main Loop
 // Process SDL Events and Draw the Frames
 //
 int Application::Run() {
 	try {
-		Graphics graphics = Graphics(_renderer);
-		Transformations transform = Transformations();
+		Graphics graphics(_renderer, _jobs);
+		Transformations transform(_jobs);
 		OnWindowResize(graphics);
 
-		// Manually define the Circles for now
-		// ... this should be done via GUI input
-		int angle = 0;
-		Pixel circleCenter(800, 400);
-		std::vector<Circle> circles{
-			{circleCenter, 120, 0, 1},
-			{circleCenter, 100, 45, 2},
-			{circleCenter, 80, 20, 4},
-			{circleCenter, 60, 0, 6},
-			{circleCenter, 40, 90, 8},
-			{circleCenter, 20, 0, 10}
-		};
-		// Workaround to get the Startpoint of the Sum-Line
-		auto tmpCircles(circles);
-		transform.Transform(tmpCircles, 1);
-		Pixel lastSumDot = tmpCircles.back().CycleDot;
-
-		// Main Loop
-		SDL_Event event;
-		uint timeStamp_new = SDL_GetTicks(), timeStamp_old = SDL_GetTicks();
-		while (!SDL_QuitRequested()) {
-			// FPS Limiter (Nice, because it works without WAIT)
-			timeStamp_new = SDL_GetTicks();
-			if ((timeStamp_new - timeStamp_old) > (1000.0f / FPS)) {
-				timeStamp_old = timeStamp_new;
-
-				// Handle all Events in the queue
-				while (SDL_PollEvent(&event)) {
-					if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_RESIZED)
-						OnWindowResize(graphics);
-				}
+		// Without a loaded Scene, the default Preset is animated as compile-time Chain (no heap, unrolled)
+		// until a Scene gets published ... this should be done via GUI input
+		if (_scene.Epoch() == 0) {
+			CircleChain<PRESET_DEFAULT.size()> chain(PRESET_DEFAULT, Pixel(800, 400));
+			float angle = 0.0f;
+			transform.Transform(chain, NextAngle(angle, 1.0f));
+			Vec2 lastSumDot = chain.SumDot();
 
-				// Update and draw the GUI (Bottom Layer)
-				KW_ProcessEvents(_gui.get());
-				KW_Paint(_gui.get());
+			const bool sceneLoaded = MainLoop(graphics, [&]() {
+				if (_scene.Epoch() != 0)
+					return false;
+
+				// Transform and draw all circles (Top Layer), the last CycleDot is the Sum
+				angle = NextAngle(angle, 1.0f);
+				transform.Transform(chain, angle);
+				graphics.Draw(chain, _canvas, chain.SumDot(), lastSumDot);
+				lastSumDot = chain.SumDot();
+				return true;
+			});
+			if (!sceneLoaded)
+				return 0;
+		}
 
-				// Constant rotation of one Degree per Frame
-				// Frequency 1 == "6 sec. for one full rotation"
-				angle = (angle > 360) ? 1 : angle + 1;
+		// Current Scene Snapshot (valid until the next Quiescent call)
+		// The Circles and the Path are animated (and edited) as working copies in _circles and _trajectory
+		const Scene* scene = nullptr;
+		uint64_t sceneEpoch = 0;
+		Vec2 lastSumDot;
 
-				// Transform and draw all circles (Top Layer)
-				transform.Transform(circles, angle);
-				graphics.Draw(circles, _backgroundPixels, lastSumDot);
-				lastSumDot = circles.back().CycleDot;
+		MainLoop(graphics, [&]() {
+			// Switch to a newly published Scene (lock-free, the Circles are only copied on a change)
+			// and start with an empty Trail. Afterwards the old Scene can be deleted by the Writer
+			// (A Scene with our own edits already matches the working copies, so the animation just continues)
+			if (_scene.Epoch() != sceneEpoch) {
+				scene = _scene.Acquire(sceneEpoch);
+				if (!scene->Edited) {
+					_circles = scene->Circles;
+					_trajectory = scene->Path;
+					_angle = 0.0f;
+					_dragCircle = -1;
+					_editFinished = false;
+					_canvas.Clear();
+					lastSumDot = SumDot(*scene, scene->AngleStep);
+				}
+				_scene.Quiescent(sceneEpoch);
 			}
-		}
+			// Finished edits are written back in the background (retried with the next Frames,
+			// while the previous write-back runs or its Scene wasn't picked up yet)
+			if (_editFinished && _scene.Epoch() == sceneEpoch
+				&& (!_editing.valid() || _editing.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+				_editFinished = false;
+				PublishEdits(sceneEpoch);
+			}
+
+			// Transform and draw all circles (Top Layer)
+			_angle = NextAngle(_angle, scene->AngleStep);
+			transform.Transform(_circles, _angle);
+			const Vec2 sumDot = SumDot(*scene, _angle);
+			graphics.Draw(_circles, _canvas, sumDot, lastSumDot);
+			lastSumDot = sumDot;
+			return true;
+		});
 
 		return 0;
 	}
@@ -98,6 +272,66 @@ int Application::Run() {
 	}
 }
 
+//
+// Position of the Sum of all Epicycles of the Scene (read from the cached Path, no Evaluation per Frame)
+// Not rounded, so the anti-aliased Trail keeps the sub-pixel position
+//
+Vec2 Application::SumDot(const Scene& scene, float angle) {
+	const Vec2 sum = _trajectory.Sample(angle);
+	return Vec2(scene.Center.X + sum.X, scene.Center.Y + sum.Y);
+}
+
+//
+// Change Radius and Angle-Offset of one displayed Circle (Main Thread only)
+// The cached Path is updated incrementally: Only the old and new contribution of this Circle are calculated
+//
+void Application::EditCircle(size_t index, float radius, float angleOffset) {
+	if (index >= _circles.size())
+		return;
+	Circle& circle = _circles[index];
+	_trajectory.Update(circle.Frequency, circle.Radius, circle.AngleOffset, radius, angleOffset);
+	circle.Radius = radius;
+	circle.AngleOffset = angleOffset;
+}
+
+//
+// Write the edited Circles back into the Scene, so they are saved and kept when the Scene is published again:
+// A copy of the Coefficients with the edited Radii and Angle-Offsets replaces the Scene (with the already
+// updated Path, nothing is synthesized again). Dropped, if a newly loaded Scene was published meanwhile
+// Built on a background Thread, the Render-Loop only copies its working state (the Circles and the Path)
+//
+void Application::PublishEdits(uint64_t epoch) {
+	_editing = std::async(std::launch::async, [this, epoch, circles = _circles, path = _trajectory]() mutable {
+		uint64_t pinned = 0;
+		const Scene* scene = _scene.Pin(pinned);
+		try {
+			if (scene != nullptr && pinned == epoch) {
+				const SpectrumView& view = scene->View;
+				Spectrum coefficients;
+				coefficients.Reserve(view.Count);
+				for (size_t i = 0; i < view.Count; i++)
+					coefficients.Add(view.GetFrequency(i), view.GetAmplitude(i), view.GetPhase(i));
+				for (size_t i = 0; i < circles.size(); i++) {
+					coefficients.Amplitude[scene->CircleCoefficients[i]] = circles[i].Radius;
+					coefficients.Phase[scene->CircleCoefficients[i]] = circles[i].AngleOffset;
+				}
+
+				std::unique_ptr<Scene> edited = std::make_unique<Scene>(std::move(coefficients), scene->Center, scene->AngleStep);
+				edited->Circles = std::move(circles);
+				edited->CircleCoefficients = scene->CircleCoefficients;
+				edited->Path = std::move(path);
+				edited->Edited = true;
+				_scene.Replace(epoch, std::move(edited));
+			}
+		}
+		catch (const std::exception& ex) {
+			std::cout << ex.what() << std::endl;
+		}
+		if (scene != nullptr)
+			_scene.Unpin(pinned);
+	});
+}
+
 //
 // Create and Show the Application Window
 //
@@ -120,36 +354,75 @@ void Application::SetupWindow() {
 void Application::SetupSDL() {
 	// Create the Renderer to draw within the Window (-1 for default Window driver)
 	// Set only the SDL_RENDERER_ACCELERATED Flag and NO Vsync! (Managing Frame-Times is important)
-	_renderer = sdl_make_shared(SDL_CreateRenderer(_window.get(), -1, SDL_RENDERER_ACCELERATED));
+	// SDL_RENDERER_TARGETTEXTURE is needed to paint the GUI into its own (cached) Texture
+	_renderer = sdl_make_shared(SDL_CreateRenderer(_window.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE));
 	if (_renderer == nullptr)
 		throw FourierException("SDL Error on Renderer creation: " + std::string(SDL_GetError()));
 }
 
 //
-// Create all the Ressources needed to work with the KiwiGUI
+// Decode the Tileset and the Font (runs on the loading Thread)
+// Both only decode Files into Surface/Font memory, the Renderer is not touched until the GUI is created
 //
-void Application::SetupKiwiGUI() {
-	// Initialize the KiWi SDL2 Render Driver
-	// You can have multiple GUI instances in the same/different windows, based on the Render Driver
-	_driver = kiwi_make_shared(KW_CreateSDL2RenderDriver(_renderer.get(), _window.get()));
-	if (_driver == nullptr)
-		throw FourierException("KiWi GUI Error creating GUI Driver: " + std::string(SDL_GetError()));
-
-	_surface = KW_LoadSurface(_driver.get(), (_resourcePath + "tileset.png").c_str());
-	if (_surface == nullptr)
+GuiResources Application::LoadGuiResources() {
+	const Uint64 start = SDL_GetPerformanceCounter();
+	GuiResources resources = { nullptr, nullptr, 0.0 };
+
+	resources.Tileset = KW_LoadSurface(_driver.get(), (_resourcePath + "tileset.png").c_str());
+	if (resources.Tileset == nullptr)
 		throw FourierException("KiWi GUI Error creating GUI Surface:" + std::string(SDL_GetError()));
 
+	// Load the font with Font-size 12
+	resources.Font = KW_LoadFont(_driver.get(), (_resourcePath + "sourcesans-pro-semibold.ttf").c_str(), 12);
+	if (resources.Font == nullptr) {
+		KW_ReleaseSurface(_driver.get(), resources.Tileset);
+		throw FourierException("KiWi GUI Error loading Font: " + std::string(SDL_GetError()));
+	}
+
+	resources.LoadTime = StartupTimer::Since(start);
+	return resources;
+}
+
+//
+// Create the KiwiGUI from the loaded Ressources (errors of the loading Thread are re-thrown here)
+//
+void Application::SetupKiwiGUI() {
+	const Uint64 start = SDL_GetPerformanceCounter();
+	const GuiResources resources = _resources.get();
+	_surface = resources.Tileset;
+	_font = resources.Font;
+	_startup.Add("GUI Ressources (async)", resources.LoadTime);
+
 	// Finally create the GUI
 	_gui = kiwi_make_shared(KW_Init(_driver.get(), _surface));
 	if (_gui == nullptr)
 		throw FourierException("KiWi GUI Error setting up the GUI: " + std::string(SDL_GetError()));
+	KW_SetFont(_gui.get(), _font);
+	InvalidateGUI();
+	_startup.Add("GUI Setup", StartupTimer::Since(start));
+}
 
-	// Load the font and set it with Font-size 12
-	_font = KW_LoadFont(_driver.get(), (_resourcePath + "sourcesans-pro-semibold.ttf").c_str(), 12);
-	if (_font != nullptr)
-		KW_SetFont(_gui.get(), _font);
-	else
-		throw FourierException("KiWi GUI Error loading Font: " + std::string(SDL_GetError()));
+//
+// Track the Startup phases and report them, once the first Frame is shown, the GUI is set up
+// and a Scene loading in the background is done
+//
+void Application::UpdateStartup() {
+	if (_startupReported)
+		return;
+	if (!_firstFrameShown) {
+		_startup.Mark("First Frame");
+		_firstFrameShown = true;
+	}
+
+	const bool loading = _loading.valid() && _loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+	if (_gui == nullptr || loading)
+		return;
+	if (_loading.valid()) {
+		_loading.get();
+		_startup.Add("Scene Loading (async)", _sceneLoadTime);
+	}
+	_startup.Report(std::cout);
+	_startupReported = true;
 }
 
 //
@@ -159,14 +432,122 @@ void Application::OnWindowResize(Graphics& graphics) {
 	// Update the Width and Height values based on the new Window size
 	SDL_GetWindowSize(_window.get(), &_actualWidth, &_actualHeight);
 
-	// Setup the background Pixel memory ("* 4" is for the rgba values of each Pixel)
-	_backgroundPixels = std::vector<byte>(_actualWidth * _actualHeight * 4, 255);
-	// Create (or refresh) the background Texture
+	// Setup the sparse background Canvas (Tiles are only allocated where the Trail is drawn)
+	// Resizing keeps the Tile memory in the Pool for reuse
+	_canvas.Resize(_actualWidth, _actualHeight, ToARGB(COLOR_WHITE));
+	CreateTextures(graphics);
+}
+
+//
+// Called on Render-Target or Device reset: The Textures (and their content) are lost, the Canvas is not
+// New Textures are created and every Tile of the Canvas is uploaded again
+//
+void Application::OnRenderReset(Graphics& graphics) {
+	CreateTextures(graphics);
+	_canvas.MarkAllDirty();
+}
+
+//
+// Create the background and GUI Layer Textures in the current Window size
+//
+void Application::CreateTextures(Graphics& graphics) {
+	// Create (or refresh) the background Texture (cleared once, then updated per dirty Tile)
 	_background = sdl_make_shared(SDL_CreateTexture(_renderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, _actualWidth, _actualHeight));
 	if (_background != nullptr)
-		graphics.UpdateBackground(_background, _actualWidth, _actualHeight);
+		graphics.UpdateBackground(_background, _actualWidth, _actualHeight, ToARGB(COLOR_WHITE));
 	else
 		throw FourierException("SDL Error on Texture creation: " + std::string(SDL_GetError()));
+
+	// Create (or refresh) the GUI Layer Texture (Render-Target with alpha, so the background shines through)
+	_guiLayer = sdl_make_shared(SDL_CreateTexture(_renderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, _actualWidth, _actualHeight));
+	if (_guiLayer == nullptr)
+		throw FourierException("SDL Error on GUI Texture creation: " + std::string(SDL_GetError()));
+	SDL_SetTextureBlendMode(_guiLayer.get(), SDL_BLENDMODE_BLEND);
+	graphics.UpdateGuiLayer(_guiLayer);
+	InvalidateGUI();
+}
+
+//
+// Called for every SDL Event
+// Only Input- and Window-Events can change the GUI state, so only those mark it as dirty
+// A Render-Target or Device reset loses the content of the cached GUI Texture, so it is re-painted as well
+//
+void Application::OnGuiEvent(const SDL_Event& event) {
+	switch (event.type) {
+	case SDL_MOUSEMOTION:
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+	case SDL_MOUSEWHEEL:
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+	case SDL_TEXTINPUT:
+	case SDL_TEXTEDITING:
+	case SDL_WINDOWEVENT:
+	case SDL_RENDER_TARGETS_RESET:
+	case SDL_RENDER_DEVICE_RESET:
+		InvalidateGUI();
+		break;
+	default:
+		break;
+	}
+}
+
+//
+// Drag the Dot of a Circle with the left Mouse-Button to change its Radius and Angle-Offset
+// (The Dot follows the Mouse: Radius is the distance to the Center, the Offset compensates the current rotation)
+//
+void Application::OnEditEvent(const SDL_Event& event) {
+	switch (event.type) {
+	case SDL_MOUSEBUTTONDOWN: {
+		if (event.button.button != SDL_BUTTON_LEFT)
+			break;
+		// Pick the closest Dot within a few Pixels
+		int bestDistance = 8 * 8;
+		_dragCircle = -1;
+		for (size_t i = 0; i < _circles.size(); i++) {
+			const int dx = event.button.x - _circles[i].CycleDot.X, dy = event.button.y - _circles[i].CycleDot.Y;
+			if ((dx * dx) + (dy * dy) <= bestDistance) {
+				bestDistance = (dx * dx) + (dy * dy);
+				_dragCircle = (int)i;
+			}
+		}
+		break;
+	}
+	case SDL_MOUSEMOTION: {
+		if (_dragCircle < 0)
+			break;
+		const Circle& circle = _circles[_dragCircle];
+		const float dx = (float)(event.motion.x - circle.Center.X), dy = (float)(event.motion.y - circle.Center.Y);
+		const float direction = atan2(dy, dx) * (180.0f / M_PI);
+		EditCircle(_dragCircle, sqrt((dx * dx) + (dy * dy)), std::fmod(direction - (_angle * circle.Frequency), 360.0f));
+		break;
+	}
+	case SDL_MOUSEBUTTONUP:
+		if (event.button.button == SDL_BUTTON_LEFT && _dragCircle >= 0) {
+			_dragCircle = -1;
+			_editFinished = true;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+//
+// Let KiWi process its queued Events and paint all Widgets into the GUI Layer Texture
+// (Instead of painting directly into the Frame, which would be needed on every single Frame)
+//
+void Application::PaintGUI() {
+	KW_ProcessEvents(_gui.get());
+
+	// Redirect all rendering into the GUI Texture and clear it (fully transparent)
+	SDL_SetRenderTarget(_renderer.get(), _guiLayer.get());
+	SDL_SetRenderDrawColor(_renderer.get(), 0, 0, 0, 0);
+	SDL_RenderClear(_renderer.get());
+	KW_Paint(_gui.get());
+	SDL_SetRenderTarget(_renderer.get(), NULL);
+
+	_guiDirty = false;
 }
 
 //
@@ -174,10 +555,26 @@ void Application::OnWindowResize(Graphics& graphics) {
 // couldn't be managed by smart-pointers automatically
 // 
 Application::~Application() {
+	// Loading Threads still use the Application (and SDL)
+	if (_loading.valid())
+		_loading.wait();
+	if (_editing.valid())
+		_editing.wait();
+	if (_resources.valid()) {
+		_resources.wait();
+		try {
+			const GuiResources resources = _resources.get();
+			_surface = resources.Tileset;
+			_font = resources.Font;
+		}
+		catch (const std::exception&) {}
+	}
+
 	if (_surface != nullptr)
 		KW_ReleaseSurface(_driver.get(), _surface);
 	if (_font != nullptr)
 		KW_ReleaseFont(_driver.get(), _font);
 
+	IMG_Quit();
 	SDL_Quit();
 }
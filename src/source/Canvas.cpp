@@ -0,0 +1,128 @@
+
+#include "../header/Canvas.hpp"
+
+using namespace Fourier;
+
+//
+// Take a free Tile (a new Block is allocated, if none is left)
+//
+ARGB* TilePool::Acquire() {
+	if (_free.empty()) {
+		_blocks.push_back(std::make_unique<ARGB[]>(TILE_POOL_BLOCK * TILE_PIXELS));
+		ARGB* block = _blocks.back().get();
+		for (size_t i = TILE_POOL_BLOCK; i > 0; i--)
+			_free.push_back(block + (i - 1) * TILE_PIXELS);
+	}
+	ARGB* tile = _free.back();
+	_free.pop_back();
+	return tile;
+}
+
+//
+// Set a new Canvas size, all Tiles are released (the whole Canvas is the clear Color again)
+// The Texture is expected to be cleared once by its owner, afterwards only dirty Tiles are uploaded
+//
+void Canvas::Resize(int width, int height, ARGB clearColor) {
+	Clear();
+	_width = std::max(width, 0);
+	_height = std::max(height, 0);
+	_tilesX = (_width + TILE_SIZE - 1) >> TILE_SHIFT;
+	_tilesY = (_height + TILE_SIZE - 1) >> TILE_SHIFT;
+	_clearColor = clearColor;
+	_tiles.assign((size_t)_tilesX * _tilesY, nullptr);
+	_dirty.assign(_tiles.size(), false);
+	_dirtyTiles.clear();
+	_clearTile.assign(TILE_PIXELS, _clearColor);
+}
+
+//
+// Release all Tiles and mark them dirty (so the Texture gets cleared as well)
+//
+void Canvas::Clear() {
+	for (size_t index : _usedTiles) {
+		_pool.Release(_tiles[index]);
+		_tiles[index] = nullptr;
+		MarkDirty(index);
+	}
+	_usedTiles.clear();
+}
+
+//
+// Mark every Tile dirty, so the next Upload fills the whole Texture again (e.g. after it was lost)
+//
+void Canvas::MarkAllDirty() {
+	for (size_t index = 0; index < _tiles.size(); index++)
+		MarkDirty(index);
+}
+
+//
+// Fade all allocated Tiles towards the clear Color (in parallel, one Tile per Job)
+// Tiles that faded out completely are released back to the Pool
+//
+void Canvas::Fade(JobSystem& jobs, byte amount) {
+	if (amount == 0 || _usedTiles.empty())
+		return;
+
+	_blank.assign(_usedTiles.size(), 0);
+	jobs.ParallelFor(0, _usedTiles.size(), 1, [this, amount](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			ARGB* tile = _tiles[_usedTiles[i]];
+			Kernels::Fade(tile, TILE_PIXELS, _clearColor, amount);
+			_blank[i] = std::all_of(tile, tile + TILE_PIXELS, [this](ARGB pixel) { return pixel == _clearColor; });
+		}
+	});
+
+	// Every faded Tile changed, blank ones are removed (swap with the last, the order doesn't matter)
+	for (size_t i = _usedTiles.size(); i > 0; i--) {
+		const size_t index = _usedTiles[i - 1];
+		MarkDirty(index);
+		if (_blank[i - 1]) {
+			_pool.Release(_tiles[index]);
+			_tiles[index] = nullptr;
+			_usedTiles[i - 1] = _usedTiles.back();
+			_usedTiles.pop_back();
+		}
+	}
+}
+
+//
+// Upload only the dirty Tiles into their region of the Texture (released Tiles upload the clear Color)
+//
+void Canvas::Upload(SDL_Texture* texture) {
+	for (size_t index : _dirtyTiles) {
+		const int tileX = (int)(index % _tilesX), tileY = (int)(index / _tilesX);
+		SDL_Rect rect;
+		rect.x = tileX << TILE_SHIFT;
+		rect.y = tileY << TILE_SHIFT;
+		rect.w = std::min(TILE_SIZE, _width - rect.x);
+		rect.h = std::min(TILE_SIZE, _height - rect.y);
+
+		const ARGB* pixels = (_tiles[index] != nullptr) ? _tiles[index] : _clearTile.data();
+		SDL_UpdateTexture(texture, &rect, pixels, TILE_SIZE * sizeof(ARGB));
+		_dirty[index] = false;
+	}
+	_dirtyTiles.clear();
+}
+
+//
+// Set a single Pixel (Pixels outside the Canvas are ignored)
+//
+void Canvas::Set(int x, int y, ARGB color) {
+	if (x < 0 || y < 0 || x >= _width || y >= _height)
+		return;
+	ForSpan(x, y, 1, [color](ARGB* pixels, size_t, size_t) { *pixels = color; });
+}
+
+//
+// Tile at "index" for drawing: Allocated (and cleared) on first use, always marked dirty
+//
+ARGB* Canvas::Tile(size_t index) {
+	ARGB*& tile = _tiles[index];
+	if (tile == nullptr) {
+		tile = _pool.Acquire();
+		Kernels::Fill(tile, TILE_PIXELS, _clearColor);
+		_usedTiles.push_back(index);
+	}
+	MarkDirty(index);
+	return tile;
+}
@@ -0,0 +1,163 @@
+
+#include "../header/CoefficientFile.hpp"
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Fourier;
+
+static uint64_t Align(uint64_t offset) { return (offset + COEFFICIENT_ALIGNMENT - 1) & ~(COEFFICIENT_ALIGNMENT - 1); }
+
+CoefficientFile::CoefficientFile(const std::string& file)
+	: _data(nullptr), _size(0),
+#ifdef _WIN32
+	_file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+#else
+	_file(-1)
+#endif
+{
+	Map(file);
+	try {
+		Validate(file);
+	}
+	catch (...) {
+		Unmap();
+		throw;
+	}
+}
+
+//
+// Map the whole File read-only into memory
+//
+void CoefficientFile::Map(const std::string& file) {
+#ifdef _WIN32
+	_file = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (_file == INVALID_HANDLE_VALUE)
+		throw FourierException("Coefficient File Error opening: " + file);
+
+	LARGE_INTEGER size;
+	GetFileSizeEx(_file, &size);
+	_size = (size_t)size.QuadPart;
+	_mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	_data = (_mapping != nullptr) ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+#else
+	_file = open(file.c_str(), O_RDONLY);
+	if (_file < 0)
+		throw FourierException("Coefficient File Error opening: " + file);
+
+	struct stat info;
+	fstat(_file, &info);
+	_size = (size_t)info.st_size;
+	void* data = (_size > 0) ? mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0) : MAP_FAILED;
+	_data = (data != MAP_FAILED) ? data : nullptr;
+#endif
+	if (_data == nullptr) {
+		Unmap();
+		throw FourierException("Coefficient File Error mapping: " + file);
+	}
+}
+
+//
+// Check the Header and that all arrays are inside the File, then point the View into the mapping
+//
+void CoefficientFile::Validate(const std::string& file) {
+	if (_size < sizeof(CoefficientHeader))
+		throw FourierException("Coefficient File Error (too small): " + file);
+
+	const CoefficientHeader& header = *(const CoefficientHeader*)_data;
+	if (std::memcmp(header.Magic, COEFFICIENT_MAGIC, sizeof(COEFFICIENT_MAGIC)) != 0)
+		throw FourierException("Coefficient File Error (not a Coefficient File): " + file);
+	if (header.Version != COEFFICIENT_VERSION)
+		throw FourierException("Coefficient File Error (unsupported Version " + std::to_string(header.Version) + "): " + file);
+
+	if (header.FileSize != (uint64_t)_size)
+		throw FourierException("Coefficient File Error (wrong size): " + file);
+
+	// Every Array has to fit into the File (compared by division, so corrupt values can't overflow)
+	const bool half = (header.Flags & COEFFICIENT_FLAG_HALF) != 0;
+	const uint64_t valueSize = half ? sizeof(ushort) : sizeof(float);
+	const uint64_t offsets[3] = { header.FrequencyOffset, header.AmplitudeOffset, header.PhaseOffset };
+	const uint64_t elementSizes[3] = { sizeof(float), valueSize, valueSize };
+	for (int i = 0; i < 3; i++) {
+		if (offsets[i] % COEFFICIENT_ALIGNMENT != 0 || offsets[i] < sizeof(CoefficientHeader) || offsets[i] > _size
+			|| header.Count > (_size - offsets[i]) / elementSizes[i])
+			throw FourierException("Coefficient File Error (corrupt Header): " + file);
+	}
+
+	const byte* data = (const byte*)_data;
+	_view = SpectrumView((size_t)header.Count, half, (const float*)(data + header.FrequencyOffset),
+		data + header.AmplitudeOffset, data + header.PhaseOffset);
+}
+
+void CoefficientFile::Unmap() {
+#ifdef _WIN32
+	if (_data != nullptr)
+		UnmapViewOfFile(_data);
+	if (_mapping != nullptr)
+		CloseHandle(_mapping);
+	if (_file != INVALID_HANDLE_VALUE)
+		CloseHandle(_file);
+	_mapping = nullptr;
+	_file = INVALID_HANDLE_VALUE;
+#else
+	if (_data != nullptr)
+		munmap((void*)_data, _size);
+	if (_file >= 0)
+		close(_file);
+	_file = -1;
+#endif
+	_data = nullptr;
+	_view = SpectrumView();
+}
+
+//
+// Write Coefficients in the binary Format (Amplitude and Phase optionally quantized to float16)
+//
+void CoefficientFile::Save(const SpectrumView& spectrum, const std::string& file, bool half) {
+	const uint64_t count = spectrum.Count;
+	const uint64_t valueSize = half ? sizeof(ushort) : sizeof(float);
+
+	CoefficientHeader header = {};
+	std::memcpy(header.Magic, COEFFICIENT_MAGIC, sizeof(COEFFICIENT_MAGIC));
+	header.Version = COEFFICIENT_VERSION;
+	header.Flags = half ? COEFFICIENT_FLAG_HALF : 0;
+	header.Count = count;
+	header.FrequencyOffset = Align(sizeof(CoefficientHeader));
+	header.AmplitudeOffset = Align(header.FrequencyOffset + count * sizeof(float));
+	header.PhaseOffset = Align(header.AmplitudeOffset + count * valueSize);
+	header.FileSize = header.PhaseOffset + count * valueSize;
+
+	// Build the whole File in memory (Padding between the arrays stays zero)
+	std::vector<byte> data((size_t)header.FileSize, 0);
+	std::memcpy(data.data(), &header, sizeof(CoefficientHeader));
+	float* frequency = (float*)(data.data() + header.FrequencyOffset);
+	for (size_t i = 0; i < count; i++) {
+		frequency[i] = spectrum.GetFrequency(i);
+		if (half) {
+			((ushort*)(data.data() + header.AmplitudeOffset))[i] = FloatToHalf(spectrum.GetAmplitude(i));
+			((ushort*)(data.data() + header.PhaseOffset))[i] = FloatToHalf(spectrum.GetPhase(i));
+		}
+		else {
+			((float*)(data.data() + header.AmplitudeOffset))[i] = spectrum.GetAmplitude(i);
+			((float*)(data.data() + header.PhaseOffset))[i] = spectrum.GetPhase(i);
+		}
+	}
+
+	std::ofstream out(file, std::ios::binary | std::ios::trunc);
+	if (!out || !out.write((const char*)data.data(), data.size()))
+		throw FourierException("Coefficient File Error writing: " + file);
+}
+
+CoefficientFile::~CoefficientFile() {
+	Unmap();
+}
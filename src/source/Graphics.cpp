@@ -3,19 +3,25 @@
 
 using namespace Fourier;
 
-void Graphics::Draw(const std::vector<Circle>& circles, std::vector<byte>& backgroundPixels, const Pixel& lastSumDot) {
+void Graphics::Draw(const Circle* circles, size_t count, Canvas& canvas, const Vec2& sumDot, const Vec2& lastSumDot) {
 	// Clear the Frame (white)
 	SDL_SetRenderDrawColor(_renderer.get(), 255, 255, 255, 255);
 	SDL_RenderClear(_renderer.get());
 
-	// Draw the background Texture
-	SDL_UpdateTexture(_background.get(), NULL, &backgroundPixels[0], _bgWidth * 4);
+	// Let the Trail fade out (only allocated Tiles, vectorized and split into Jobs) and draw the background Texture
+	// Only Tiles changed since the last Frame are uploaded
+	canvas.Fade(_jobs, TRAIL_FADE);
+	canvas.Upload(_background.get());
 	SDL_RenderCopy(_renderer.get(), _background.get(), NULL, NULL);
 
+	// Composite the cached GUI Texture (only re-painted by the Application if the GUI changed)
+	if (_guiLayer != nullptr)
+		SDL_RenderCopy(_renderer.get(), _guiLayer.get(), NULL, NULL);
+
 	// Draw all Circles
-	if (circles.size()) {
+	if (count > 0) {
 		// Draw the Grid-Lines
-		const Pixel& center = circles.front().Center;
+		const Pixel& center = circles[0].Center;
 		SetSolidDrawing(false);
 		SetColor(COLOR_GRAY_LIGHT);
 		DrawLine_B(Pixel(center.X - 300, center.Y), Pixel(center.X + 300, center.Y));
@@ -23,7 +29,10 @@ void Graphics::Draw(const std::vector<Circle>& circles, std::vector<byte>& backg
 
 		// And for each Circle draw: 
 		// The Circle itself, a Dot on the circumference and a Line (Center to Dot)
-		for (const Circle& c : circles) {
+		for (size_t i = 0; i < count; i++) {
+			const Circle& c = circles[i];
+			if (c.Radius < 1.0f)
+				continue;
 			SetColor(COLOR_GRAY_MEDIUM);
 			SetSolidDrawing(false);
 			DrawCircle(c.Radius, c.Center);
@@ -35,11 +44,11 @@ void Graphics::Draw(const std::vector<Circle>& circles, std::vector<byte>& backg
 		}
 
 		// Draw the SUM 
-		// CycleDot on outer Circle + a Line on the Background Texture (Sum will be very dotted, with only Pixels)
-		const Pixel& sumDot = circles.back().CycleDot;
+		// Sum of all Epicycles + an anti-aliased Line on the Background Texture (connecting the last and current Sum)
+		// The Line uses the exact (sub-pixel) positions, only the Dot is rounded to whole Pixels
 		SetColor(COLOR_BLUE);
-		DrawDot(4, sumDot);
-		DrawLine_B_Background(backgroundPixels, lastSumDot, sumDot, COLOR_BLUE);
+		DrawDot(4, Pixel(sumDot.X + 0.5f, sumDot.Y + 0.5f));
+		DrawLine_AA_Background(canvas, lastSumDot, sumDot, COLOR_BLUE);
 	}
 
 	// Render to the Window
@@ -50,10 +59,28 @@ void Graphics::Draw(const std::vector<Circle>& circles, std::vector<byte>& backg
 // Set a updated Background Texture (not the acutal Pixels tho)
 // Should be called on every Window-Resize Event
 //
-void Graphics::UpdateBackground(std::shared_ptr<SDL_Texture> background, int bgWidth, int bgHeight) {
+// The new Texture is cleared once with the clear Color, afterwards only dirty Canvas Tiles are uploaded
+//
+void Graphics::UpdateBackground(std::shared_ptr<SDL_Texture> background, int bgWidth, int bgHeight, ARGB clearColor) {
 	_background = background;
 	_bgWidth = bgWidth;
 	_bgHeight = bgHeight;
+
+	void* pixels = nullptr;
+	int pitch = 0;
+	if (SDL_LockTexture(_background.get(), NULL, &pixels, &pitch) == 0) {
+		for (int y = 0; y < _bgHeight; y++)
+			Kernels::Fill((ARGB*)((byte*)pixels + (size_t)pitch * y), _bgWidth, clearColor);
+		SDL_UnlockTexture(_background.get());
+	}
+}
+
+//
+// Set a updated GUI Layer Texture, composited on top of the Background
+// Should be called on every Window-Resize Event
+//
+void Graphics::UpdateGuiLayer(std::shared_ptr<SDL_Texture> guiLayer) {
+	_guiLayer = guiLayer;
 }
 
 //
@@ -101,6 +128,12 @@ void Graphics::DrawLine_N(const Pixel& from, const Pixel& to) {
 //           DrawLine_B is ~27 times faster with compiler-optimization
 //
 void Graphics::DrawLine_B(const Pixel& from, const Pixel& to) {
+	// Solid Lines are filled as Polygon instead of 9 Pixels per Line-Pixel
+	if (_solidDrawing) {
+		DrawThickLine(from, to, 3.0f);
+		return;
+	}
+
 	int x0 = from.X, y0 = from.Y, x1 = to.X, y1 = to.Y;
 	const int deltaX = abs(x1 - x0);
 	const int deltaY = abs(y1 - y0);
@@ -131,35 +164,75 @@ void Graphics::DrawLine_B(const Pixel& from, const Pixel& to) {
 }
 
 //
-// Same as DrawLine_B but Pixels are added on the Background Texture, not directly to the Renderer
-// 
-void Graphics::DrawLine_B_Background(std::vector<byte>& backgroundPixels, const Pixel& from, const Pixel& to, const Color& color) {
-	int x0 = from.X, y0 = from.Y, x1 = to.X, y1 = to.Y;
-	const int deltaX = abs(x1 - x0);
-	const int deltaY = abs(y1 - y0);
-	// Check Slope direction (X Axis: [Left -] to [Right +], Y Axis: [Top -] to [Bottom +])
-	const int sx = (x0 < x1) ? 1 : -1;
-	const int sy = (y0 < y1) ? 1 : -1;
-	int err = (deltaX > deltaY ? deltaX : -deltaY) / 2;
-	int errTmp = err;
+// Clip the range of "rx" to the values where: lo <= (a * rx + b) <= hi
+// (Helper for the Span calculation of DrawLine_AA_Background)
+//
+static void ClipSpan(float a, float b, float lo, float hi, float& minRx, float& maxRx) {
+	if (fabs(a) < 1e-6f) {
+		// Constant over the whole Row: Either everything or nothing is inside
+		if (b < lo || b > hi)
+			maxRx = minRx - 1.0f;
+		return;
+	}
+	float r0 = (lo - b) / a, r1 = (hi - b) / a;
+	if (r0 > r1)
+		std::swap(r0, r1);
+	minRx = std::max(minRx, r0);
+	maxRx = std::min(maxRx, r1);
+}
 
-	for (;;) {
-		// Draw until Line reached the last Pixel
-		SetBackgroundPixel(backgroundPixels, x0, y0, color);
-		if (x0 == x1 && y0 == y1)
-			break;
+//
+// Anti-aliased Line-Drawing Algorithm on the Background Texture
+// Coverage-based (like Xiaolin Wu's Algorithm, but with a variable Line width)
+//
+// For every Row the exact Span of Pixels touched by the Segment is calculated first,
+// then Coverage and Blending of the whole Span are done in SIMD lanes by the Pixel Kernels
+// The Segment has flat ends, so the Trail (a chain of Segments) doesn't blend any Pixel twice
+//
+void Graphics::DrawLine_AA_Background(Canvas& canvas, const Vec2& from, const Vec2& to, const Color& color) {
+	// Start and End point shifted by half a Pixel, so Pixel (x, y) covers [x, x + 1) x [y, y + 1)
+	const Kernels::Segment segment(from.X + 0.5f, from.Y + 0.5f, to.X + 0.5f, to.Y + 0.5f, _trailWidth);
+	if (segment.Length2 <= 0.0f || canvas.Width() <= 0)
+		return;
 
-		errTmp = err;
-		// Step the X Axis
-		if (errTmp > -deltaX) {
-			err -= deltaY;
-			x0 += sx;
-		}
-		// Step the Y Axis
-		if (errTmp < deltaY) {
-			err += deltaX;
-			y0 += sy;
-		}
+	const ARGB packed = ToARGB(color);
+	const float edge = segment.HalfWidth + 0.5f;
+	const float edgeLength = edge / segment.InvLength;
+	const int yMin = std::max(0, (int)floor(std::min(segment.Y, segment.Y + segment.DY) - edge));
+	const int yMax = std::min(canvas.Height() - 1, (int)ceil(std::max(segment.Y, segment.Y + segment.DY) + edge));
+
+	for (int y = yMin; y <= yMax; y++) {
+		// Relative to the Segment start: Distance and Projection are both linear in rx
+		// |cross| = |rx * dy - ry * dx| <= edge * length  and  0 <= proj = rx * dx + ry * dy <= length^2
+		const float ry = (y + 0.5f) - segment.Y;
+		float minRx = 0.5f - segment.X, maxRx = (canvas.Width() - 0.5f) - segment.X;
+		ClipSpan(segment.DY, -ry * segment.DX, -edgeLength, edgeLength, minRx, maxRx);
+		ClipSpan(segment.DX, ry * segment.DY, 0.0f, segment.Length2, minRx, maxRx);
+		if (minRx > maxRx)
+			continue;
+
+		// Back to Pixel coordinates (one Pixel extra on both sides, the exact edge is handled by the Coverage)
+		const int x0 = std::max(0, (int)floor(minRx + segment.X - 0.5f) - 1);
+		const int x1 = std::min(canvas.Width() - 1, (int)ceil(maxRx + segment.X - 0.5f) + 1);
+		const size_t count = x1 - x0 + 1;
+		if (_coverage.size() < count)
+			_coverage.resize(count);
+
+		Kernels::Coverage(_coverage.data(), count, x0 + 0.5f, y + 0.5f, segment);
+
+		// Skip uncovered Pixels on both ends (so no Tile is allocated just for them)
+		// and blend the rest, split at the Tile boundaries
+		size_t first = 0, last = count;
+		while (first < last && _coverage[first] == 0)
+			first++;
+		while (last > first && _coverage[last - 1] == 0)
+			last--;
+		if (first == last)
+			continue;
+		const byte* coverage = _coverage.data() + first;
+		canvas.ForSpan(x0 + (int)first, y, last - first, [coverage, packed](ARGB* pixels, size_t offset, size_t length) {
+			Kernels::BlendMask(pixels, coverage + offset, length, packed);
+		});
 	}
 }
 
@@ -171,6 +244,12 @@ void Graphics::DrawLine_B_Background(std::vector<byte>& backgroundPixels, const
 // Convert Pythagoras (r^2 = x^2 + y^2) to get Y based on R and X: y = √(r^2 - x^2)
 //
 void Graphics::DrawCircle(ushort radius, const Pixel& center) {
+	// Solid Circles are a 3 Pixel wide Ring of Spans (instead of 9 Pixels per Circle-Pixel)
+	if (_solidDrawing) {
+		FillRing(center, radius + 1, radius - 2);
+		return;
+	}
+
 	const int cX = center.X, cY = center.Y;
 	const int rs = (radius * radius);
 	// Only loop X for 1/8 of the circumference and calculate the according Y values
@@ -192,20 +271,118 @@ void Graphics::DrawCircle(ushort radius, const Pixel& center) {
 	}
 }
 
+//
+// Thick-Line-Drawing Algorithm
+//
+// The Line is a Rectangle around the Segment (extended by half the width on both ends, like a square brush)
+// and filled as convex Polygon, so every covered Pixel is drawn exactly once
+//
+void Graphics::DrawThickLine(const Pixel& from, const Pixel& to, float width) {
+	const float halfWidth = width * 0.5f;
+	Vec2 direction(to.X - from.X, to.Y - from.Y);
+	const float length = sqrt(direction.X * direction.X + direction.Y * direction.Y);
+	if (length > 0.0f)
+		direction /= length;
+	else
+		direction = Vec2(1.0f, 0.0f);
+
+	// Along the Line (d) and perpendicular to it (n), both scaled to half the width
+	const Vec2 d(direction.X * halfWidth, direction.Y * halfWidth);
+	const Vec2 n(-d.Y, d.X);
+	const Vec2 start(from.X + 0.5f - d.X, from.Y + 0.5f - d.Y), end(to.X + 0.5f + d.X, to.Y + 0.5f + d.Y);
+	const Vec2 corners[4] = {
+		Vec2(start.X + n.X, start.Y + n.Y), Vec2(end.X + n.X, end.Y + n.Y),
+		Vec2(end.X - n.X, end.Y - n.Y), Vec2(start.X - n.X, start.Y - n.Y)
+	};
+	FillConvex(corners, 4);
+}
+
 //
 // Filled-Circle-Drawing Algorithm
-// Based on: https://stackoverflow.com/a/1237519
 //
-// Simple (brute-force) way of drawing a Dot, only using integer multiplications and additions
-// For a very basic Version use:					if (x * x + y * y <= radius * radius)
-// For "Close to" Midpoint-Algorithm result use:	if (x * x + y * y <= radius * radius + radius * 0.8f)
+// Dots are filled with horizontal Spans (one per Row) based on the Midpoint-Algorithm
+// In Solid-Drawing mode the Dot grows by one Pixel (the same size as the former 3x3 Pixels per Dot-Pixel)
 //
 void Graphics::DrawDot(ushort radius, const Pixel& center) {
-	const int cX = center.X, cY = center.Y;
-	for (int y = -radius; y <= radius; y++)
-		for (int x = -radius; x <= radius; x++)
-			if (x * x + y * y <= radius * radius + radius * 0.8f)
-				SetPixel(cX + x, cY + y);
+	FillRing(center, radius + (_solidDrawing ? 1 : 0), -1);
+}
+
+//
+// Fill all Pixels between the Circles with radius "inner" (exclusive, -1 for a full Dot) and "outer"
+//
+// The Midpoint-Algorithm walks one octant of the Circle and mirrors it, which gives the half-width
+// of every Row. Each Row is then one Span (or two, left and right of the inner Circle)
+//
+void Graphics::FillRing(const Pixel& center, int outer, int inner) {
+	if (outer < 0)
+		return;
+	inner = std::min(inner, outer - 1);
+
+	// Half-widths of the Rows [0, outer] of the outer Circle, followed by [0, inner] of the inner one
+	_extents.assign(outer + 1 + std::max(inner + 1, 0), -1);
+	for (int pass = 0; pass < 2; pass++) {
+		const int radius = (pass == 0) ? outer : inner;
+		int* extents = _extents.data() + ((pass == 0) ? 0 : outer + 1);
+		int x = radius, y = 0, err = 1 - radius;
+		while (x >= y) {
+			extents[y] = std::max(extents[y], x);
+			extents[x] = std::max(extents[x], y);
+			y++;
+			if (err < 0) {
+				err += 2 * y + 1;
+			}
+			else {
+				x--;
+				err += 2 * (y - x) + 1;
+			}
+		}
+	}
+
+	const int* innerExtents = _extents.data() + outer + 1;
+	for (int dy = -outer; dy <= outer; dy++) {
+		const int row = abs(dy);
+		const int outerX = _extents[row];
+		const int innerX = (row <= inner) ? innerExtents[row] : -1;
+		if (innerX < 0) {
+			AddSpan(center.X - outerX, center.Y + dy, 2 * outerX + 1);
+		}
+		else {
+			AddSpan(center.X - outerX, center.Y + dy, outerX - innerX);
+			AddSpan(center.X + innerX + 1, center.Y + dy, outerX - innerX);
+		}
+	}
+	FlushSpans();
+}
+
+//
+// Scanline-Fill of a convex Polygon (Points in Pixel coordinates, Pixel-Centers at +0.5)
+// For every Row the Polygon edges are intersected with the Row center, which gives exactly one Span
+//
+void Graphics::FillConvex(const Vec2* points, size_t count) {
+	float minY = points[0].Y, maxY = points[0].Y;
+	for (size_t i = 1; i < count; i++) {
+		minY = std::min(minY, points[i].Y);
+		maxY = std::max(maxY, points[i].Y);
+	}
+
+	for (int y = (int)ceil(minY - 0.5f); y + 0.5f <= maxY; y++) {
+		const float py = y + 0.5f;
+		float minX = INFINITY, maxX = -INFINITY;
+		for (size_t i = 0; i < count; i++) {
+			const Vec2& a = points[i];
+			const Vec2& b = points[(i + 1) % count];
+			if ((py < a.Y && py < b.Y) || (py > a.Y && py > b.Y))
+				continue;
+			// Horizontal edges only add their end points
+			const float x = (a.Y == b.Y) ? a.X : a.X + (py - a.Y) * (b.X - a.X) / (b.Y - a.Y);
+			minX = std::min(minX, (a.Y == b.Y) ? std::min(a.X, b.X) : x);
+			maxX = std::max(maxX, (a.Y == b.Y) ? std::max(a.X, b.X) : x);
+		}
+		// Pixels with their center inside [minX, maxX]
+		const int x0 = (int)ceil(minX - 0.5f), x1 = (int)floor(maxX - 0.5f);
+		AddSpan(x0, y, x1 - x0 + 1);
+	}
+	FlushSpans();
 }
 
 //
@@ -248,31 +425,25 @@ void Graphics::SetColor(const Color& color) {
 
 //
 // Draw a Pixel
-// (In case Solid-Drawing is active: Draw 9 Pixels instead of just one for better visibility)
+// (In case Solid-Drawing is active: Draw a 3x3 Pixel square instead of just one for better visibility)
+// Lines, Circles and Dots handle Solid-Drawing with Spans themselves, so they never overdraw
 // 
 void Graphics::SetPixel(const Pixel& pixel) { SetPixel(pixel.X, pixel.Y); }
 void Graphics::SetPixel(const ushort& x, const ushort& y) {
-	SDL_RenderDrawPoint(_renderer.get(), x, y);
 	if (_solidDrawing) {
-		SDL_RenderDrawPoint(_renderer.get(), x - 1, y);
-		SDL_RenderDrawPoint(_renderer.get(), x + 1, y);
-		SDL_RenderDrawPoint(_renderer.get(), x, y - 1);
-		SDL_RenderDrawPoint(_renderer.get(), x, y + 1);
-		SDL_RenderDrawPoint(_renderer.get(), x - 1, y - 1);
-		SDL_RenderDrawPoint(_renderer.get(), x + 1, y - 1);
-		SDL_RenderDrawPoint(_renderer.get(), x - 1, y + 1);
-		SDL_RenderDrawPoint(_renderer.get(), x + 1, y + 1);
+		const SDL_Rect square = { x - 1, y - 1, 3, 3 };
+		SDL_RenderFillRect(_renderer.get(), &square);
+	}
+	else {
+		SDL_RenderDrawPoint(_renderer.get(), x, y);
 	}
 }
 
 //
-// Draw a Pixel onto the Background Texture
+// Submit all collected Spans at once
 //
-void Graphics::SetBackgroundPixel(std::vector<byte>& backgroundPixels, ushort x, ushort y, const Color& color) {
-	// Get the offset to access a "two-dimensional" point in the one-dimensional array
-	const uint offset = (_bgWidth * 4 * y) + x * 4;
-	backgroundPixels[offset + 0] = color.b;
-	backgroundPixels[offset + 1] = color.g;
-	backgroundPixels[offset + 2] = color.r;
-	backgroundPixels[offset + 3] = 0;
+void Graphics::FlushSpans() {
+	if (!_spans.empty())
+		SDL_RenderFillRects(_renderer.get(), _spans.data(), (int)_spans.size());
+	_spans.clear();
 }
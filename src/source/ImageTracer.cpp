@@ -0,0 +1,308 @@
+
+#include "../header/ImageTracer.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Fourier;
+
+// Canny thresholds, relative to the strongest Edge in the Image
+static const float CANNY_LOW = 0.08f;
+static const float CANNY_HIGH = 0.2f;
+// Contours with less Points are considered noise
+static const size_t MIN_CONTOUR = 3;
+
+// Edge classification (_edges)
+static const byte EDGE_NONE = 0;
+static const byte EDGE_WEAK = 1;
+static const byte EDGE_STRONG = 2;
+
+// 8-Neighbourhood: Direct neighbours first, so traced Contours prefer straight steps
+static const int NEIGHBOURS_X[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+static const int NEIGHBOURS_Y[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+//
+// Run the whole Pipeline and return one closed Path (in Image coordinates)
+//
+std::vector<Vec2> ImageTracer::Trace(const std::string& file) {
+	LoadGrayscale(file);
+	Blur();
+	Sobel();
+	const float maxMagnitude = Suppress();
+	Hysteresis(maxMagnitude * CANNY_LOW, maxMagnitude * CANNY_HIGH);
+
+	const std::vector<std::vector<Vec2>> contours = TraceContours();
+	if (contours.empty())
+		throw FourierException("Image Tracing Error: No edges found in " + file);
+	return OrderContours(contours);
+}
+
+//
+// Center a Path on (0, 0) and scale it, so the larger side of its bounding box equals "size"
+//
+void ImageTracer::Normalize(std::vector<Vec2>& path, float size) {
+	if (path.empty())
+		return;
+
+	Vec2 min = path.front(), max = path.front();
+	for (const Vec2& p : path) {
+		min = Vec2(std::min(min.X, p.X), std::min(min.Y, p.Y));
+		max = Vec2(std::max(max.X, p.X), std::max(max.Y, p.Y));
+	}
+	const Vec2 center = (min + max) * 0.5f;
+	const float extent = std::max(max.X - min.X, max.Y - min.Y);
+	const float scale = (extent > 0.0f) ? size / extent : 1.0f;
+	for (Vec2& p : path)
+		p = (p - center) * scale;
+}
+
+//
+// Load the Image via SDL_image and convert it to grayscale [0, 255]
+// (Transparent Pixels are treated as white background)
+//
+void ImageTracer::LoadGrayscale(const std::string& file) {
+	std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loaded(IMG_Load(file.c_str()), SDL_FreeSurface);
+	if (loaded == nullptr)
+		throw FourierException("SDL_image Error loading Image: " + std::string(SDL_GetError()));
+
+	std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface(SDL_ConvertSurfaceFormat(loaded.get(), SDL_PIXELFORMAT_ARGB8888, 0), SDL_FreeSurface);
+	if (surface == nullptr)
+		throw FourierException("SDL Error converting Image: " + std::string(SDL_GetError()));
+
+	_width = surface->w;
+	_height = surface->h;
+	_gray.resize((size_t)_width * _height);
+
+	SDL_LockSurface(surface.get());
+	const byte* pixels = (const byte*)surface->pixels;
+	const int pitch = surface->pitch;
+	ParallelRows([this, pixels, pitch](int y0, int y1) {
+		for (int y = y0; y < y1; y++) {
+			const uint* row = (const uint*)(pixels + (size_t)pitch * y);
+			float* gray = &_gray[(size_t)_width * y];
+			for (int x = 0; x < _width; x++) {
+				const uint p = row[x];
+				const float a = ((p >> 24) & 0xFF) / 255.0f;
+				const float luma = 0.299f * ((p >> 16) & 0xFF) + 0.587f * ((p >> 8) & 0xFF) + 0.114f * (p & 0xFF);
+				gray[x] = (luma * a) + (255.0f * (1.0f - a));
+			}
+		}
+	});
+	SDL_UnlockSurface(surface.get());
+}
+
+//
+// Separable 5x5 Gaussian Blur (Kernel: 1 4 6 4 1 / 16) to reduce noise before the Edge-Detection
+// Horizontal pass into the buffer, vertical pass back (each Pass needs the full result of the previous)
+//
+void ImageTracer::Blur() {
+	const float kernel[5] = { 1.0f / 16, 4.0f / 16, 6.0f / 16, 4.0f / 16, 1.0f / 16 };
+	_buffer.resize(_gray.size());
+
+	ParallelRows([this, &kernel](int y0, int y1) {
+		for (int y = y0; y < y1; y++) {
+			const float* src = &_gray[(size_t)_width * y];
+			float* dst = &_buffer[(size_t)_width * y];
+			for (int x = 0; x < _width; x++) {
+				float sum = 0.0f;
+				for (int k = -2; k <= 2; k++)
+					sum += kernel[k + 2] * src[std::min(std::max(x + k, 0), _width - 1)];
+				dst[x] = sum;
+			}
+		}
+	});
+	ParallelRows([this, &kernel](int y0, int y1) {
+		for (int y = y0; y < y1; y++) {
+			float* dst = &_gray[(size_t)_width * y];
+			for (int x = 0; x < _width; x++)
+				dst[x] = 0.0f;
+			for (int k = -2; k <= 2; k++) {
+				const float* src = &_buffer[(size_t)_width * std::min(std::max(y + k, 0), _height - 1)];
+				for (int x = 0; x < _width; x++)
+					dst[x] += kernel[k + 2] * src[x];
+			}
+		}
+	});
+}
+
+//
+// Sobel Operator: Gradient magnitude (into the buffer) and its direction rounded to 45 Degrees
+// 0 = horizontal, 1 = diagonal (down-right), 2 = vertical, 3 = diagonal (down-left)
+//
+void ImageTracer::Sobel() {
+	_direction.assign(_gray.size(), 0);
+	std::fill(_buffer.begin(), _buffer.end(), 0.0f);
+
+	ParallelRows([this](int y0, int y1) {
+		for (int y = std::max(y0, 1); y < std::min(y1, _height - 1); y++) {
+			const float* above = &_gray[(size_t)_width * (y - 1)];
+			const float* row = &_gray[(size_t)_width * y];
+			const float* below = &_gray[(size_t)_width * (y + 1)];
+			for (int x = 1; x < _width - 1; x++) {
+				const float gx = (above[x + 1] + 2 * row[x + 1] + below[x + 1]) - (above[x - 1] + 2 * row[x - 1] + below[x - 1]);
+				const float gy = (below[x - 1] + 2 * below[x] + below[x + 1]) - (above[x - 1] + 2 * above[x] + above[x + 1]);
+				const size_t i = (size_t)_width * y + x;
+				_buffer[i] = std::sqrt((gx * gx) + (gy * gy));
+
+				// tan(22.5) = 0.4142 and tan(67.5) = 2.4142 are the borders between the directions
+				const float ax = std::fabs(gx), ay = std::fabs(gy);
+				_direction[i] = (ay <= ax * 0.4142f) ? 0 : (ay >= ax * 2.4142f) ? 2 : ((gx * gy > 0) ? 1 : 3);
+			}
+		}
+	});
+}
+
+//
+// Non-Maximum Suppression: Only keep Pixels that are the maximum along their gradient direction
+// The thinned magnitude ends up in _gray (no longer needed) and the max. magnitude is returned
+//
+float ImageTracer::Suppress() {
+	static const int offsetX[4] = { 1, 1, 0, -1 };
+	static const int offsetY[4] = { 0, 1, 1, 1 };
+	std::vector<float> bandMax(_height, 0.0f);
+
+	ParallelRows([this, &bandMax](int y0, int y1) {
+		for (int y = y0; y < y1; y++) {
+			float* dst = &_gray[(size_t)_width * y];
+			for (int x = 0; x < _width; x++) {
+				const size_t i = (size_t)_width * y + x;
+				const float m = _buffer[i];
+				dst[x] = 0.0f;
+				if (m <= 0.0f || x == 0 || y == 0 || x == _width - 1 || y == _height - 1)
+					continue;
+				const int d = _direction[i];
+				const long offset = (long)_width * offsetY[d] + offsetX[d];
+				if (m >= _buffer[i + offset] && m >= _buffer[i - offset]) {
+					dst[x] = m;
+					bandMax[y] = std::max(bandMax[y], m);
+				}
+			}
+		}
+	});
+	return *std::max_element(bandMax.begin(), bandMax.end());
+}
+
+//
+// Double-Threshold and Hysteresis: Strong Edges are kept,
+// weak Edges only if they are connected to a strong Edge (Flood-Fill starting at all strong Edges)
+//
+void ImageTracer::Hysteresis(float low, float high) {
+	_edges.assign(_gray.size(), EDGE_NONE);
+	ParallelRows([this, low, high](int y0, int y1) {
+		for (size_t i = (size_t)_width * y0; i < (size_t)_width * y1; i++)
+			_edges[i] = (_gray[i] >= high) ? EDGE_STRONG : (_gray[i] >= low) ? EDGE_WEAK : EDGE_NONE;
+	});
+
+	std::vector<size_t> stack;
+	for (size_t i = 0; i < _edges.size(); i++) {
+		if (_edges[i] != EDGE_STRONG)
+			continue;
+		stack.push_back(i);
+		while (!stack.empty()) {
+			const size_t p = stack.back();
+			stack.pop_back();
+			const int x = (int)(p % _width), y = (int)(p / _width);
+			for (int n = 0; n < 8; n++) {
+				const int nx = x + NEIGHBOURS_X[n], ny = y + NEIGHBOURS_Y[n];
+				if (nx < 0 || ny < 0 || nx >= _width || ny >= _height)
+					continue;
+				const size_t ni = (size_t)_width * ny + nx;
+				if (_edges[ni] == EDGE_WEAK) {
+					_edges[ni] = EDGE_STRONG;
+					stack.push_back(ni);
+				}
+			}
+		}
+	}
+}
+
+//
+// Collect all connected Edge-Pixels as ordered Contours
+// Starting at any Edge-Pixel the Contour is followed in both directions, and every used Pixel is cleared
+//
+std::vector<std::vector<Vec2>> ImageTracer::TraceContours() {
+	std::vector<std::vector<Vec2>> contours;
+	for (int y = 0; y < _height; y++) {
+		for (int x = 0; x < _width; x++) {
+			if (_edges[(size_t)_width * y + x] != EDGE_STRONG)
+				continue;
+			_edges[(size_t)_width * y + x] = EDGE_NONE;
+
+			// Follow one direction, then the other one from the same start and join both halves
+			std::vector<Vec2> forward = Follow(x, y);
+			std::vector<Vec2> contour = Follow(x, y);
+			std::reverse(contour.begin(), contour.end());
+			contour.emplace_back((float)x, (float)y);
+			contour.insert(contour.end(), forward.begin(), forward.end());
+
+			if (contour.size() >= MIN_CONTOUR)
+				contours.push_back(std::move(contour));
+		}
+	}
+	return contours;
+}
+
+//
+// Walk along the Edge-Pixels (starting next to x, y) as long as there is a neighbouring Edge-Pixel
+//
+std::vector<Vec2> ImageTracer::Follow(int x, int y) {
+	std::vector<Vec2> points;
+	for (;;) {
+		int n = 0;
+		for (; n < 8; n++) {
+			const int nx = x + NEIGHBOURS_X[n], ny = y + NEIGHBOURS_Y[n];
+			if (nx >= 0 && ny >= 0 && nx < _width && ny < _height && _edges[(size_t)_width * ny + nx] == EDGE_STRONG)
+				break;
+		}
+		if (n == 8)
+			return points;
+
+		x += NEIGHBOURS_X[n];
+		y += NEIGHBOURS_Y[n];
+		_edges[(size_t)_width * y + x] = EDGE_NONE;
+		points.emplace_back((float)x, (float)y);
+	}
+}
+
+//
+// Join all Contours into one Path with a nearest-neighbour Tour
+// The k-d tree holds both end-points of every Contour not used yet, so the next Contour
+// is the one with the closest end-point (traversed in reverse, if that's its last Point)
+//
+std::vector<Vec2> ImageTracer::OrderContours(const std::vector<std::vector<Vec2>>& contours) {
+	std::vector<Vec2> endPoints;
+	size_t total = 0;
+	endPoints.reserve(contours.size() * 2);
+	for (const std::vector<Vec2>& contour : contours) {
+		endPoints.push_back(contour.front());
+		endPoints.push_back(contour.back());
+		total += contour.size();
+	}
+
+	KdTree tree(endPoints);
+	std::vector<Vec2> path;
+	path.reserve(total);
+	size_t next = 0;
+	bool reversed = false;
+	for (;;) {
+		const std::vector<Vec2>& contour = contours[next];
+		if (reversed)
+			path.insert(path.end(), contour.rbegin(), contour.rend());
+		else
+			path.insert(path.end(), contour.begin(), contour.end());
+		tree.Remove((uint)(next * 2));
+		tree.Remove((uint)(next * 2 + 1));
+
+		const int nearest = tree.Nearest(path.back());
+		if (nearest < 0)
+			return path;
+		next = nearest / 2;
+		reversed = (nearest % 2 == 1);
+	}
+}
+
+//
+// Split the Image into Bands of Rows and process all Bands in parallel on the JobSystem
+//
+void ImageTracer::ParallelRows(const std::function<void(int, int)>& rows) {
+	_jobs.ParallelFor(0, _height, IMAGE_BAND_ROWS, [&rows](size_t y0, size_t y1) { rows((int)y0, (int)y1); });
+}
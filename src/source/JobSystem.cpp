@@ -0,0 +1,148 @@
+
+#include "../header/JobSystem.hpp"
+
+using namespace Fourier;
+
+// Max. number of Jobs waiting in one Queue (Jobs beyond that are executed directly)
+static const size_t QUEUE_CAPACITY = 1024;
+
+// Queue of the current Thread: Workers use their own, every other Thread shares Queue 0
+static thread_local size_t t_queue = 0;
+
+JobSystem::JobSystem(size_t threads)
+	: _queued(0), _stop(false) {
+	threads = std::max(threads, (size_t)1);
+	for (size_t i = 0; i < threads; i++) {
+		_queues.push_back(std::make_unique<Queue>());
+		_queues.back()->Jobs.resize(QUEUE_CAPACITY);
+	}
+	// The Thread waiting for the Jobs works as well, so one Worker less than Threads
+	for (size_t i = 1; i < threads; i++) {
+		_workers.emplace_back([this, i]() {
+			t_queue = i;
+			WorkerLoop();
+		});
+	}
+}
+
+//
+// Submit a single Job (its Pending counter must be incremented by the caller)
+//
+void JobSystem::Submit(const Job& job) {
+	if (_workers.empty() || !Push(job)) {
+		Execute(job);
+		return;
+	}
+	Wake();
+}
+
+//
+// Execute Jobs until all Jobs of "pending" are done
+// Workers take any Job (own Queue first, then stolen ones), other Threads only the Jobs of their own group:
+// They share Queue 0, so e.g. the Render-Loop would otherwise end up running the long Jobs of a Loading-Thread
+//
+void JobSystem::Wait(std::atomic<size_t>& pending) {
+	const bool worker = (t_queue != 0);
+	Job job;
+	while (pending.load(std::memory_order_acquire) > 0) {
+		if (worker ? (Pop(job) || Steal(job)) : PopGroup(job, pending))
+			Execute(job);
+		else
+			std::this_thread::yield();
+	}
+}
+
+bool JobSystem::Push(const Job& job) {
+	Queue& queue = *_queues[t_queue];
+	{
+		std::lock_guard<std::mutex> lock(queue.Lock);
+		if (queue.Tail - queue.Head >= QUEUE_CAPACITY)
+			return false;
+		queue.Jobs[queue.Tail % QUEUE_CAPACITY] = job;
+		queue.Tail++;
+	}
+	_queued++;
+	return true;
+}
+
+//
+// Take the newest Job of the own Queue
+//
+bool JobSystem::Pop(Job& job) {
+	Queue& queue = *_queues[t_queue];
+	std::lock_guard<std::mutex> lock(queue.Lock);
+	if (queue.Tail == queue.Head)
+		return false;
+	queue.Tail--;
+	job = queue.Jobs[queue.Tail % QUEUE_CAPACITY];
+	_queued--;
+	return true;
+}
+
+//
+// Take the newest Job of the own Queue, but only if it belongs to the group of "pending"
+//
+bool JobSystem::PopGroup(Job& job, const std::atomic<size_t>& pending) {
+	Queue& queue = *_queues[t_queue];
+	std::lock_guard<std::mutex> lock(queue.Lock);
+	if (queue.Tail == queue.Head || queue.Jobs[(queue.Tail - 1) % QUEUE_CAPACITY].Pending != &pending)
+		return false;
+	queue.Tail--;
+	job = queue.Jobs[queue.Tail % QUEUE_CAPACITY];
+	_queued--;
+	return true;
+}
+
+//
+// Take the oldest Job of any other Queue (usually the biggest remaining piece of work)
+//
+bool JobSystem::Steal(Job& job) {
+	for (size_t i = 1; i < _queues.size(); i++) {
+		Queue& queue = *_queues[(t_queue + i) % _queues.size()];
+		std::lock_guard<std::mutex> lock(queue.Lock);
+		if (queue.Tail == queue.Head)
+			continue;
+		job = queue.Jobs[queue.Head % QUEUE_CAPACITY];
+		queue.Head++;
+		_queued--;
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::Execute(const Job& job) {
+	job.Function(job.Data, job.Begin, job.End);
+	job.Pending->fetch_sub(1, std::memory_order_release);
+}
+
+//
+// Wake up sleeping Workers (the lock makes sure no Worker is between its check and going to sleep)
+//
+void JobSystem::Wake() {
+	{
+		std::lock_guard<std::mutex> lock(_sleepLock);
+	}
+	_wake.notify_all();
+}
+
+void JobSystem::WorkerLoop() {
+	Job job;
+	while (!_stop) {
+		if (Pop(job) || Steal(job)) {
+			Execute(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_sleepLock);
+		_wake.wait(lock, [this]() { return _queued.load() > 0 || _stop; });
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(_sleepLock);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (std::thread& worker : _workers)
+		worker.join();
+}
@@ -0,0 +1,97 @@
+
+#include "../header/KdTree.hpp"
+
+using namespace Fourier;
+
+KdTree::KdTree(const std::vector<Vec2>& points)
+	: _points(points), _ids(points.size()), _slots(points.size()), _alive(points.size()), _removed(points.size(), false) {
+	std::iota(_ids.begin(), _ids.end(), 0);
+	Build(0, (uint)_ids.size(), 0);
+
+	// Reorder the Points into the tree layout (better cache-locality for the queries)
+	std::vector<Vec2> ordered(_ids.size());
+	for (uint slot = 0; slot < _ids.size(); slot++) {
+		ordered[slot] = _points[_ids[slot]];
+		_slots[_ids[slot]] = slot;
+	}
+	_points.swap(ordered);
+}
+
+//
+// Recursively split the range at its median (X and Y axis alternating)
+//
+void KdTree::Build(uint lo, uint hi, uint depth) {
+	if (lo >= hi)
+		return;
+	const uint mid = (lo + hi) / 2;
+	const bool axisX = (depth % 2 == 0);
+	std::nth_element(_ids.begin() + lo, _ids.begin() + mid, _ids.begin() + hi, [this, axisX](uint a, uint b) {
+		return axisX ? (_points[a].X < _points[b].X) : (_points[a].Y < _points[b].Y);
+	});
+	_alive[mid] = hi - lo;
+	Build(lo, mid, depth + 1);
+	Build(mid + 1, hi, depth + 1);
+}
+
+//
+// Get the id of the nearest Point that was not removed yet (or -1 if the tree is empty)
+//
+int KdTree::Nearest(const Vec2& query) const {
+	int best = -1;
+	float bestDistance = std::numeric_limits<float>::max();
+	Nearest(query, 0, (uint)_ids.size(), 0, best, bestDistance);
+	return best;
+}
+
+void KdTree::Nearest(const Vec2& query, uint lo, uint hi, uint depth, int& best, float& bestDistance) const {
+	if (lo >= hi)
+		return;
+	const uint mid = (lo + hi) / 2;
+	if (_alive[mid] == 0)
+		return;
+
+	const Vec2& point = _points[mid];
+	if (!_removed[mid]) {
+		const Vec2 delta = point - query;
+		const float distance = delta.dot(delta);
+		if (distance < bestDistance) {
+			bestDistance = distance;
+			best = (int)_ids[mid];
+		}
+	}
+
+	// Search the side of the query first, the other side only if it could contain a closer Point
+	const float split = (depth % 2 == 0) ? (query.X - point.X) : (query.Y - point.Y);
+	if (split < 0) {
+		Nearest(query, lo, mid, depth + 1, best, bestDistance);
+		if (split * split < bestDistance)
+			Nearest(query, mid + 1, hi, depth + 1, best, bestDistance);
+	}
+	else {
+		Nearest(query, mid + 1, hi, depth + 1, best, bestDistance);
+		if (split * split < bestDistance)
+			Nearest(query, lo, mid, depth + 1, best, bestDistance);
+	}
+}
+
+//
+// Remove a Point: Walk down to its node and update the alive count of all nodes on the way
+//
+void KdTree::Remove(uint id) {
+	const uint slot = _slots[id];
+	if (_removed[slot])
+		return;
+	_removed[slot] = true;
+
+	uint lo = 0, hi = (uint)_ids.size();
+	while (lo < hi) {
+		const uint mid = (lo + hi) / 2;
+		_alive[mid]--;
+		if (slot == mid)
+			break;
+		if (slot < mid)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+}
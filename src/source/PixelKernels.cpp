@@ -0,0 +1,246 @@
+
+#include "../header/PixelKernels.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(FOURIER_AVX2)
+#include <immintrin.h>
+#elif defined(FOURIER_SSE2)
+#include <emmintrin.h>
+#endif
+
+using namespace Fourier;
+
+//
+// Scalar helpers (used for the Span remainder and as the fallback without SIMD)
+// All calculations happen per 8-Bit channel, widened to 32-Bit integers
+//
+static inline ARGB BlendPixel(ARGB d, ARGB s, uint a, uint ia) {
+	ARGB result = 0;
+	for (uint shift = 0; shift < 32; shift += 8) {
+		const uint dc = (d >> shift) & 0xFF, sc = (s >> shift) & 0xFF;
+		result |= (((dc * ia) + (sc * a) + 128) >> 8) << shift;
+	}
+	return result;
+}
+
+static inline ARGB FadePixel(ARGB d, ARGB t, uint amount) {
+	ARGB result = 0;
+	for (uint shift = 0; shift < 32; shift += 8) {
+		const uint dc = (d >> shift) & 0xFF, tc = (t >> shift) & 0xFF;
+		const uint hi = std::max(dc, tc), lo = std::min(dc, tc);
+		const uint step = ((hi - lo) * amount + 255) >> 8;
+		result |= ((dc < tc) ? dc + step : dc - step) << shift;
+	}
+	return result;
+}
+
+static inline byte CoveragePixel(float rx, float ry, const Kernels::Segment& s) {
+	const float proj = (rx * s.DX) + (ry * s.DY);
+	if (proj < 0.0f || proj >= s.Length2)
+		return 0;
+	const float dist = std::fabs((rx * s.DY) - (ry * s.DX)) * s.InvLength;
+	const float c = std::min(std::max(s.HalfWidth + 0.5f - dist, 0.0f), 1.0f);
+	return (byte)(c * 255.0f + 0.5f);
+}
+
+//
+// SIMD helpers
+// The 8-Bit channels are unpacked into 16-Bit lanes, so the products (max. 255 * 256) don't overflow
+// Blend uses: (dst * (256 - a) + src * a + 128) >> 8
+// Fade uses:  step = ((max - min) * amount + 255) >> 8, then dst +/- step (depending on direction)
+//
+#if defined(FOURIER_AVX2)
+static inline __m256i Blend16(__m256i d, __m256i srcMul, __m256i invAlpha) {
+	const __m256i round = _mm256_set1_epi16(128);
+	return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(d, invAlpha), srcMul), round), 8);
+}
+
+static inline __m256i Fade16(__m256i d, __m256i t, __m256i amount) {
+	const __m256i bias = _mm256_set1_epi16(255);
+	const __m256i diff = _mm256_sub_epi16(_mm256_max_epi16(d, t), _mm256_min_epi16(d, t));
+	const __m256i step = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(diff, amount), bias), 8);
+	const __m256i up = _mm256_cmpgt_epi16(t, d);
+	return _mm256_sub_epi16(_mm256_add_epi16(d, _mm256_and_si256(up, step)), _mm256_andnot_si256(up, step));
+}
+
+static inline __m256i BlendMask16(__m256i d, __m256i src, __m256i alpha) {
+	const __m256i a = _mm256_add_epi16(alpha, _mm256_srli_epi16(alpha, 7));
+	const __m256i ia = _mm256_sub_epi16(_mm256_set1_epi16(256), a);
+	return Blend16(d, _mm256_mullo_epi16(src, a), ia);
+}
+#elif defined(FOURIER_SSE2)
+static inline __m128i Blend16(__m128i d, __m128i srcMul, __m128i invAlpha) {
+	const __m128i round = _mm_set1_epi16(128);
+	return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(d, invAlpha), srcMul), round), 8);
+}
+
+static inline __m128i Fade16(__m128i d, __m128i t, __m128i amount) {
+	const __m128i bias = _mm_set1_epi16(255);
+	const __m128i diff = _mm_sub_epi16(_mm_max_epi16(d, t), _mm_min_epi16(d, t));
+	const __m128i step = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(diff, amount), bias), 8);
+	const __m128i up = _mm_cmpgt_epi16(t, d);
+	return _mm_sub_epi16(_mm_add_epi16(d, _mm_and_si128(up, step)), _mm_andnot_si128(up, step));
+}
+
+static inline __m128i BlendMask16(__m128i d, __m128i src, __m128i alpha) {
+	const __m128i a = _mm_add_epi16(alpha, _mm_srli_epi16(alpha, 7));
+	const __m128i ia = _mm_sub_epi16(_mm_set1_epi16(256), a);
+	return Blend16(d, _mm_mullo_epi16(src, a), ia);
+}
+#endif
+
+void Kernels::Fill(ARGB* dst, size_t count, ARGB value) {
+	size_t i = 0;
+#if defined(FOURIER_AVX2)
+	const __m256i v = _mm256_set1_epi32((int)value);
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_si256((__m256i*)(dst + i), v);
+#elif defined(FOURIER_SSE2)
+	const __m128i v = _mm_set1_epi32((int)value);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_si128((__m128i*)(dst + i), v);
+#endif
+	for (; i < count; i++)
+		dst[i] = value;
+}
+
+void Kernels::Blend(ARGB* dst, size_t count, ARGB color, byte alpha) {
+	// Map alpha [0, 255] to [0, 256], so 255 is fully opaque after the ">> 8"
+	const uint a = alpha + (alpha >> 7);
+	const uint ia = 256 - a;
+	size_t i = 0;
+#if defined(FOURIER_AVX2)
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i invAlpha = _mm256_set1_epi16((short)ia);
+	const __m256i srcMul = _mm256_mullo_epi16(_mm256_unpacklo_epi8(_mm256_set1_epi32((int)color), zero), _mm256_set1_epi16((short)a));
+	for (; i + 8 <= count; i += 8) {
+		const __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+		const __m256i lo = Blend16(_mm256_unpacklo_epi8(d, zero), srcMul, invAlpha);
+		const __m256i hi = Blend16(_mm256_unpackhi_epi8(d, zero), srcMul, invAlpha);
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_packus_epi16(lo, hi));
+	}
+#elif defined(FOURIER_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i invAlpha = _mm_set1_epi16((short)ia);
+	const __m128i srcMul = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero), _mm_set1_epi16((short)a));
+	for (; i + 4 <= count; i += 4) {
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		const __m128i lo = Blend16(_mm_unpacklo_epi8(d, zero), srcMul, invAlpha);
+		const __m128i hi = Blend16(_mm_unpackhi_epi8(d, zero), srcMul, invAlpha);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = BlendPixel(dst[i], color, a, ia);
+}
+
+void Kernels::Fade(ARGB* dst, size_t count, ARGB target, byte amount) {
+	if (amount == 0)
+		return;
+	size_t i = 0;
+#if defined(FOURIER_AVX2)
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i t = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)target), zero);
+	const __m256i a = _mm256_set1_epi16(amount);
+	for (; i + 8 <= count; i += 8) {
+		const __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+		const __m256i lo = Fade16(_mm256_unpacklo_epi8(d, zero), t, a);
+		const __m256i hi = Fade16(_mm256_unpackhi_epi8(d, zero), t, a);
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_packus_epi16(lo, hi));
+	}
+#elif defined(FOURIER_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i t = _mm_unpacklo_epi8(_mm_set1_epi32((int)target), zero);
+	const __m128i a = _mm_set1_epi16(amount);
+	for (; i + 4 <= count; i += 4) {
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		const __m128i lo = Fade16(_mm_unpacklo_epi8(d, zero), t, a);
+		const __m128i hi = Fade16(_mm_unpackhi_epi8(d, zero), t, a);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = FadePixel(dst[i], target, amount);
+}
+
+void Kernels::BlendMask(ARGB* dst, const byte* mask, size_t count, ARGB color) {
+	size_t i = 0;
+#if defined(FOURIER_AVX2)
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i src = _mm256_unpacklo_epi8(_mm256_set1_epi32((int)color), zero);
+	const __m256i spread = _mm256_set1_epi32(0x01010101);
+	for (; i + 8 <= count; i += 8) {
+		// Widen the 8 mask bytes to one 32-Bit lane per Pixel and copy the alpha into all 4 channels
+		const __m256i m = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(mask + i))), spread);
+		const __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+		const __m256i lo = BlendMask16(_mm256_unpacklo_epi8(d, zero), src, _mm256_unpacklo_epi8(m, zero));
+		const __m256i hi = BlendMask16(_mm256_unpackhi_epi8(d, zero), src, _mm256_unpackhi_epi8(m, zero));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_packus_epi16(lo, hi));
+	}
+#elif defined(FOURIER_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+	for (; i + 4 <= count; i += 4) {
+		// Copy the 4 mask bytes into all 4 channels of their Pixel
+		int bytes;
+		std::memcpy(&bytes, mask + i, sizeof(int));
+		__m128i m = _mm_cvtsi32_si128(bytes);
+		m = _mm_unpacklo_epi8(m, m);
+		m = _mm_unpacklo_epi16(m, m);
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		const __m128i lo = BlendMask16(_mm_unpacklo_epi8(d, zero), src, _mm_unpacklo_epi8(m, zero));
+		const __m128i hi = BlendMask16(_mm_unpackhi_epi8(d, zero), src, _mm_unpackhi_epi8(m, zero));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < count; i++) {
+		const uint a = mask[i] + (mask[i] >> 7);
+		dst[i] = BlendPixel(dst[i], color, a, 256 - a);
+	}
+}
+
+void Kernels::Coverage(byte* dst, size_t count, float px, float py, const Segment& segment) {
+	// Pixel-Center relative to the Segment start
+	const float rx0 = px - segment.X;
+	const float ry = py - segment.Y;
+	size_t i = 0;
+#if defined(FOURIER_AVX2)
+	const __m256 dx = _mm256_set1_ps(segment.DX), dy = _mm256_set1_ps(segment.DY);
+	const __m256 ryDX = _mm256_set1_ps(ry * segment.DX), ryDY = _mm256_set1_ps(ry * segment.DY);
+	const __m256 invLength = _mm256_set1_ps(segment.InvLength), length2 = _mm256_set1_ps(segment.Length2);
+	const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), scale = _mm256_set1_ps(255.0f), half = _mm256_set1_ps(0.5f);
+	const __m256 vEdge = _mm256_set1_ps(segment.HalfWidth + 0.5f), sign = _mm256_set1_ps(-0.0f);
+	const __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+	for (; i + 8 <= count; i += 8) {
+		const __m256 rx = _mm256_add_ps(_mm256_set1_ps(rx0 + (float)i), lanes);
+		const __m256 proj = _mm256_add_ps(_mm256_mul_ps(rx, dx), ryDY);
+		const __m256 inside = _mm256_and_ps(_mm256_cmp_ps(proj, zero, _CMP_GE_OQ), _mm256_cmp_ps(proj, length2, _CMP_LT_OQ));
+		const __m256 dist = _mm256_mul_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_mul_ps(rx, dy), ryDX)), invLength);
+		const __m256 c = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(vEdge, dist), zero), one);
+		const __m256i ci = _mm256_cvttps_epi32(_mm256_and_ps(inside, _mm256_add_ps(_mm256_mul_ps(c, scale), half)));
+		const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(ci), _mm256_extracti128_si256(ci, 1));
+		_mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(packed, packed));
+	}
+#elif defined(FOURIER_SSE2)
+	const __m128 dx = _mm_set1_ps(segment.DX), dy = _mm_set1_ps(segment.DY);
+	const __m128 ryDX = _mm_set1_ps(ry * segment.DX), ryDY = _mm_set1_ps(ry * segment.DY);
+	const __m128 invLength = _mm_set1_ps(segment.InvLength), length2 = _mm_set1_ps(segment.Length2);
+	const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), scale = _mm_set1_ps(255.0f), half = _mm_set1_ps(0.5f);
+	const __m128 vEdge = _mm_set1_ps(segment.HalfWidth + 0.5f), sign = _mm_set1_ps(-0.0f);
+	const __m128 lanes = _mm_setr_ps(0, 1, 2, 3);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 rx = _mm_add_ps(_mm_set1_ps(rx0 + (float)i), lanes);
+		const __m128 proj = _mm_add_ps(_mm_mul_ps(rx, dx), ryDY);
+		const __m128 inside = _mm_and_ps(_mm_cmpge_ps(proj, zero), _mm_cmplt_ps(proj, length2));
+		const __m128 dist = _mm_mul_ps(_mm_andnot_ps(sign, _mm_sub_ps(_mm_mul_ps(rx, dy), ryDX)), invLength);
+		const __m128 c = _mm_min_ps(_mm_max_ps(_mm_sub_ps(vEdge, dist), zero), one);
+		const __m128i ci = _mm_cvttps_epi32(_mm_and_ps(inside, _mm_add_ps(_mm_mul_ps(c, scale), half)));
+		const __m128i packed = _mm_packs_epi32(ci, ci);
+		const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+		std::memcpy(dst + i, &bytes, sizeof(int));
+	}
+#endif
+	for (; i < count; i++)
+		dst[i] = CoveragePixel(rx0 + (float)i, ry, segment);
+}
@@ -0,0 +1,204 @@
+
+#include "../header/Trajectory.hpp"
+#include <algorithm>
+#include <complex>
+
+#if defined(FOURIER_AVX2)
+#include <immintrin.h>
+#elif defined(FOURIER_SSE2)
+#include <emmintrin.h>
+#endif
+
+using namespace Fourier;
+
+// Steps the float rotations are advanced by complex multiplication, before they start again
+// from exact values (kept in double precision), so float errors can't pile up
+static const size_t TRAJECTORY_RESEED = 8;
+//
+// e^(i * 2 * PI * frequency * sample / size), with the angle reduced to one Period first (in double precision)
+//
+static inline std::complex<double> Rotation(float frequency, size_t sample, size_t size) {
+	const double turns = std::fmod((double)frequency * (double)sample, (double)size) / (double)size;
+	return std::polar(1.0, turns * 2.0 * M_PI);
+}
+
+//
+// Add c * e^(i * 2 * PI * frequency * s / size) to the Samples s in [begin, end) (x and y start at Sample "begin")
+// The rotations of neighbouring Samples are kept in SIMD lanes and advanced by "lanes" Samples per step
+// After TRAJECTORY_RESEED steps the lanes are loaded again from double rotations, which are advanced
+// by one multiplication per lane (no sin/cos)
+//
+static void AddTerm(float* x, float* y, size_t begin, size_t end, size_t size, float frequency, float cRe, float cIm) {
+	size_t s = begin;
+#if defined(FOURIER_AVX2) || defined(FOURIER_SSE2)
+#if defined(FOURIER_AVX2)
+	const size_t lanes = 8;
+#else
+	const size_t lanes = 4;
+#endif
+	if (end - begin >= lanes) {
+		std::complex<double> seeds[8];
+		for (size_t l = 0; l < lanes; l++)
+			seeds[l] = Rotation(frequency, begin + l, size);
+		const std::complex<double> reseed = Rotation(frequency, lanes * TRAJECTORY_RESEED, size);
+		const std::complex<double> step = Rotation(frequency, lanes, size);
+		alignas(32) float re[8], im[8];
+#if defined(FOURIER_AVX2)
+		const __m256 wRe = _mm256_set1_ps((float)step.real()), wIm = _mm256_set1_ps((float)step.imag());
+		const __m256 vcRe = _mm256_set1_ps(cRe), vcIm = _mm256_set1_ps(cIm);
+#else
+		const __m128 wRe = _mm_set1_ps((float)step.real()), wIm = _mm_set1_ps((float)step.imag());
+		const __m128 vcRe = _mm_set1_ps(cRe), vcIm = _mm_set1_ps(cIm);
+#endif
+		while (s + lanes <= end) {
+			const size_t blockEnd = std::min(s + lanes * TRAJECTORY_RESEED, end);
+			for (size_t l = 0; l < lanes; l++) {
+				re[l] = (float)seeds[l].real();
+				im[l] = (float)seeds[l].imag();
+				seeds[l] *= reseed;
+			}
+#if defined(FOURIER_AVX2)
+			__m256 rRe = _mm256_load_ps(re), rIm = _mm256_load_ps(im);
+			for (; s + lanes <= blockEnd; s += lanes) {
+				const __m256 dx = _mm256_sub_ps(_mm256_mul_ps(vcRe, rRe), _mm256_mul_ps(vcIm, rIm));
+				const __m256 dy = _mm256_add_ps(_mm256_mul_ps(vcRe, rIm), _mm256_mul_ps(vcIm, rRe));
+				_mm256_storeu_ps(x + (s - begin), _mm256_add_ps(_mm256_loadu_ps(x + (s - begin)), dx));
+				_mm256_storeu_ps(y + (s - begin), _mm256_add_ps(_mm256_loadu_ps(y + (s - begin)), dy));
+				const __m256 nRe = _mm256_sub_ps(_mm256_mul_ps(rRe, wRe), _mm256_mul_ps(rIm, wIm));
+				rIm = _mm256_add_ps(_mm256_mul_ps(rRe, wIm), _mm256_mul_ps(rIm, wRe));
+				rRe = nRe;
+			}
+#else
+			__m128 rRe = _mm_load_ps(re), rIm = _mm_load_ps(im);
+			for (; s + lanes <= blockEnd; s += lanes) {
+				const __m128 dx = _mm_sub_ps(_mm_mul_ps(vcRe, rRe), _mm_mul_ps(vcIm, rIm));
+				const __m128 dy = _mm_add_ps(_mm_mul_ps(vcRe, rIm), _mm_mul_ps(vcIm, rRe));
+				_mm_storeu_ps(x + (s - begin), _mm_add_ps(_mm_loadu_ps(x + (s - begin)), dx));
+				_mm_storeu_ps(y + (s - begin), _mm_add_ps(_mm_loadu_ps(y + (s - begin)), dy));
+				const __m128 nRe = _mm_sub_ps(_mm_mul_ps(rRe, wRe), _mm_mul_ps(rIm, wIm));
+				rIm = _mm_add_ps(_mm_mul_ps(rRe, wIm), _mm_mul_ps(rIm, wRe));
+				rRe = nRe;
+			}
+#endif
+		}
+	}
+#endif
+	// Remainder (or everything without SIMD): Same recurrence with one lane
+	if (s < end) {
+		std::complex<double> seed = Rotation(frequency, s, size);
+		const std::complex<double> reseed = Rotation(frequency, TRAJECTORY_RESEED, size);
+		const std::complex<double> step = Rotation(frequency, 1, size);
+		const float wRe = (float)step.real(), wIm = (float)step.imag();
+		while (s < end) {
+			const size_t blockEnd = std::min(s + TRAJECTORY_RESEED, end);
+			float rRe = (float)seed.real(), rIm = (float)seed.imag();
+			seed *= reseed;
+			for (; s < blockEnd; s++) {
+				x[s - begin] += (cRe * rRe) - (cIm * rIm);
+				y[s - begin] += (cRe * rIm) + (cIm * rRe);
+				const float nRe = (rRe * wRe) - (rIm * wIm);
+				rIm = (rRe * wIm) + (rIm * wRe);
+				rRe = nRe;
+			}
+		}
+	}
+}
+
+// Amplitude and Phase (Degrees) as complex number
+static inline void Polar(float amplitude, float phase, float& re, float& im) {
+	const float ar = phase * (float)(M_PI / 180.0);
+	re = amplitude * std::cos(ar);
+	im = amplitude * std::sin(ar);
+}
+
+//
+// Calculate all Samples from scratch
+// At the Samples an Epicycle with a whole Frequency f is the same as one with (f mod size): All Coefficients
+// are added into "size" Frequency-bins first (O(Count)), then one inverse DFT of the used bins gives
+// the Samples (O(bins * size), independent of the Count, split into Sample-ranges on the JobSystem)
+// Both in double precision. Fractional Frequencies (not written by this App) are added one by one
+//
+void Trajectory::Synthesize(const SpectrumView& spectrum, size_t size, JobSystem& jobs) {
+	_x.assign(size, 0.0f);
+	_y.assign(size, 0.0f);
+	if (size == 0)
+		return;
+
+	std::vector<std::complex<double>> bins(size);
+	std::vector<size_t> fractional;
+	for (size_t i = 0; i < spectrum.Count; i++) {
+		const double frequency = spectrum.GetFrequency(i);
+		if (!std::isfinite(frequency))
+			continue;
+		if (frequency != std::floor(frequency)) {
+			fractional.push_back(i);
+			continue;
+		}
+		float cRe, cIm;
+		Polar(spectrum.GetAmplitude(i), spectrum.GetPhase(i), cRe, cIm);
+		const double bin = std::fmod(frequency, (double)size);
+		bins[(size_t)((bin < 0.0) ? bin + size : bin)] += std::complex<double>(cRe, cIm);
+	}
+
+	std::vector<size_t> used;
+	for (size_t b = 0; b < size; b++) {
+		if (bins[b] != std::complex<double>())
+			used.push_back(b);
+	}
+	std::vector<double> rootRe(size), rootIm(size);
+	for (size_t k = 0; k < size; k++) {
+		rootRe[k] = std::cos(2.0 * M_PI * (double)k / (double)size);
+		rootIm[k] = std::sin(2.0 * M_PI * (double)k / (double)size);
+	}
+
+	// Every bin adds bins[b] * root[(b * s) mod size] to the Samples s of the range (the root index just steps by b)
+	jobs.ParallelFor(0, size, 1, [this, &bins, &used, &rootRe, &rootIm, size](size_t begin, size_t end) {
+		std::vector<double> sumX(end - begin, 0.0), sumY(end - begin, 0.0);
+		for (size_t b : used) {
+			const double cRe = bins[b].real(), cIm = bins[b].imag();
+			size_t root = (size_t)(((unsigned long long)b * begin) % size);
+			for (size_t s = 0; s < end - begin; s++) {
+				sumX[s] += (cRe * rootRe[root]) - (cIm * rootIm[root]);
+				sumY[s] += (cRe * rootIm[root]) + (cIm * rootRe[root]);
+				root += b;
+				if (root >= size)
+					root -= size;
+			}
+		}
+		for (size_t s = begin; s < end; s++) {
+			_x[s] = (float)sumX[s - begin];
+			_y[s] = (float)sumY[s - begin];
+		}
+	});
+
+	for (size_t i : fractional) {
+		float cRe, cIm;
+		Polar(spectrum.GetAmplitude(i), spectrum.GetPhase(i), cRe, cIm);
+		AddTerm(_x.data(), _y.data(), 0, size, size, spectrum.GetFrequency(i), cRe, cIm);
+	}
+}
+
+//
+// Replace the contribution of one Epicycle: Only the difference of both terms is added (O(size))
+// (Both terms share the Frequency: new - old = (c_new - c_old) * e^(i * angle * Frequency))
+//
+void Trajectory::Update(float frequency, float oldAmplitude, float oldPhase, float newAmplitude, float newPhase) {
+	float oldRe, oldIm, newRe, newIm;
+	Polar(oldAmplitude, oldPhase, oldRe, oldIm);
+	Polar(newAmplitude, newPhase, newRe, newIm);
+	AddTerm(_x.data(), _y.data(), 0, Size(), Size(), frequency, newRe - oldRe, newIm - oldIm);
+}
+
+//
+// Position on the Path at the angle (Degrees), linearly interpolated between the two closest Samples
+//
+Vec2 Trajectory::Sample(float angle) const {
+	if (_x.empty())
+		return Vec2();
+	const float position = (angle / 360.0f) * Size();
+	const float base = std::floor(position);
+	const float t = position - base;
+	const size_t i0 = (size_t)(((long long)base % (long long)Size() + (long long)Size()) % (long long)Size());
+	const size_t i1 = (i0 + 1) % Size();
+	return Vec2(_x[i0] + (_x[i1] - _x[i0]) * t, _y[i0] + (_y[i1] - _y[i0]) * t);
+}
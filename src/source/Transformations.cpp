@@ -3,22 +3,135 @@
 
 using namespace Fourier;
 
+// Butterflies per Job of the parallel FFT
+static const size_t FFT_BATCH = 4096;
+
+//
+// Chain all Circles: Each Circle is centered on the CycleDot of the previous one
+// (The positions are accumulated as float, so rounding errors don't add up over many Circles)
+//
 void Transformations::Transform(std::vector<Circle>& circles, float angle) {
-	Pixel prevDot = circles.front().Center;
-	for (Circle& c : circles) {
-		c.Center = prevDot;
+	if (circles.empty())
+		return;
+	Vec2 prevDot(circles.front().Center.X, circles.front().Center.Y);
+	for (Circle& c : circles)
+		Chain(c, prevDot, angle);
+}
+
+//
+// Discrete Fourier Transform of a closed Path (Points as complex numbers: x + iy)
+//
+// The Path is resampled to a power of two (max. "maxSize") for the radix-2 FFT
+// Every resulting Coefficient c(k) is one Epicycle: Amplitude |c(k)|, Phase arg(c(k)), rotating k times per Period
+// Frequencies above size/2 are the negative (clockwise) Frequencies
+//
+Spectrum Transformations::FFT(const std::vector<Vec2>& path, size_t maxSize) {
+	size_t size = 1;
+	while (size < path.size() && size < maxSize)
+		size <<= 1;
+
+	const std::vector<Vec2> samples = Resample(path, size);
+	std::vector<std::complex<double>> values(size);
+	for (size_t i = 0; i < size; i++)
+		values[i] = std::complex<double>(samples[i].X, samples[i].Y);
+	FFT(values);
 
-		Rotate(c, angle);
+	Spectrum spectrum;
+	spectrum.Reserve(size);
+	for (size_t k = 0; k < size; k++) {
+		const std::complex<double> c = values[k] / (double)size;
+		const float frequency = (k < size / 2) ? (float)k : (float)k - (float)size;
+		spectrum.Add(frequency, (float)std::abs(c), (float)(std::arg(c) * 180.0 / M_PI));
+	}
+	spectrum.SortByAmplitude();
+	return spectrum;
+}
 
-		prevDot = c.CycleDot;
+//
+// Create the Circles for the first "count" Coefficients of a Spectrum (starting at "center")
+// Circles smaller than half a Pixel are invisible and left out, as well as Coefficients whose
+// Frequency is no whole number in the range of an int (only possible with corrupt Coefficient Files)
+// The index of the Coefficient of every Circle is stored in "coefficients" (if given)
+//
+std::vector<Circle> Transformations::ToCircles(const SpectrumView& spectrum, const Pixel& center, size_t count, std::vector<size_t>* coefficients) {
+	std::vector<Circle> circles;
+	circles.reserve(std::min(count, spectrum.Count));
+	if (coefficients != nullptr)
+		coefficients->clear();
+	for (size_t i = 0; i < spectrum.Count && circles.size() < count; i++) {
+		const float amplitude = spectrum.GetAmplitude(i);
+		const float frequency = spectrum.GetFrequency(i);
+		if (amplitude >= 0.5f && std::fabs(frequency) < (float)INT_MAX && frequency == std::floor(frequency)) {
+			circles.emplace_back(center, amplitude, spectrum.GetPhase(i), (int)frequency);
+			if (coefficients != nullptr)
+				coefficients->push_back(i);
+		}
 	}
+	return circles;
 }
 
-void Transformations::Rotate(Circle& circle, float angle) {
-	const Pixel center = circle.Center;
-	const float radius = circle.Radius;
-	const float ar = ((angle * circle.Frequency) + circle.AngleOffset) * (M_PI / 180);
+//
+// Resample a closed Path to "size" Points with equal distances (based on the arc length)
+//
+std::vector<Vec2> Transformations::Resample(const std::vector<Vec2>& path, size_t size) {
+	std::vector<Vec2> samples(size);
+	if (path.empty())
+		return samples;
 
-	// Update the Dot position on the Circle circumference based on the new angle
-	circle.CycleDot = Pixel(radius * cos(ar) + center.X, radius * sin(ar) + center.Y);
+	// Accumulated length up to each Point (including the closing Line back to the first Point)
+	std::vector<float> lengths(path.size() + 1, 0.0f);
+	for (size_t i = 1; i <= path.size(); i++)
+		lengths[i] = lengths[i - 1] + (path[i % path.size()] - path[i - 1]).length();
+
+	const float step = lengths.back() / size;
+	size_t segment = 0;
+	for (size_t i = 0; i < size; i++) {
+		const float position = step * i;
+		while (segment + 1 < path.size() && lengths[segment + 1] < position)
+			segment++;
+		const float length = lengths[segment + 1] - lengths[segment];
+		const float t = (length > 0.0f) ? (position - lengths[segment]) / length : 0.0f;
+		samples[i] = path[segment] + (path[(segment + 1) % path.size()] - path[segment]) * t;
+	}
+	return samples;
+}
+
+//
+// Iterative radix-2 Cooley-Tukey FFT (in-place, size must be a power of two)
+// The Butterflies of each Stage are independent, so every Stage is split into Batches on the JobSystem
+//
+void Transformations::FFT(std::vector<std::complex<double>>& values) {
+	const size_t size = values.size();
+
+	// Bit-reversal permutation
+	for (size_t i = 1, j = 0; i < size; i++) {
+		size_t bit = size >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(values[i], values[j]);
+	}
+
+	// Twiddle factors e^(-2 * PI * i * j / size), shared by all Stages
+	std::vector<std::complex<double>> twiddles(size / 2);
+	_jobs.ParallelFor(0, size / 2, FFT_BATCH, [&twiddles, size](size_t begin, size_t end) {
+		for (size_t j = begin; j < end; j++)
+			twiddles[j] = std::polar(1.0, -2.0 * M_PI * j / size);
+	});
+
+	// Butterflies: Combine two DFTs of half the length per Stage (size / 2 Butterflies per Stage)
+	for (size_t length = 2; length <= size; length <<= 1) {
+		const size_t half = length / 2, stride = size / length;
+		_jobs.ParallelFor(0, size / 2, FFT_BATCH, [&values, &twiddles, length, half, stride](size_t begin, size_t end) {
+			for (size_t b = begin; b < end; b++) {
+				const size_t k = b % half;
+				const size_t i = (b / half) * length + k;
+				const std::complex<double> even = values[i];
+				const std::complex<double> odd = values[i + half] * twiddles[k * stride];
+				values[i] = even + odd;
+				values[i + half] = even - odd;
+			}
+		});
+	}
 }
@@ -4,5 +4,23 @@
 int main(int argc, const char* argv[]) {
 	// Setup the actual App and start the main loop
 	Fourier::Application app("Fourier", 1280, 720, BASE_PATH);
-	return (app.InitApplication()) ? app.Run() : -1;
+	if (!app.InitApplication())
+		return -1;
+
+	// Optional: Image or Coefficient File to draw with Epicycles (Default Circles otherwise)
+	// and a File to save the Coefficients to ("--half" to quantize them to float16)
+	// Loaded in the background, the Default Circles are shown until the Scene is ready
+	if (argc > 1) {
+		const std::string scene(argv[1]);
+		const std::string extension(SCENE_EXTENSION);
+		const bool isScene = scene.size() >= extension.size() && scene.compare(scene.size() - extension.size(), extension.size(), extension) == 0;
+		const std::string saveFile = (argc > 2) ? argv[2] : "";
+		const bool half = argc > 3 && std::string(argv[3]) == "--half";
+		app.LoadAsync([&app, scene, isScene, saveFile, half]() {
+			const bool loaded = isScene ? app.LoadScene(scene) : app.LoadImage(scene);
+			if (loaded && !saveFile.empty())
+				app.SaveScene(saveFile, half);
+		});
+	}
+	return app.Run();
 }